@@ -1,12 +1,25 @@
 #ifndef BRANCHING_DISCRETE_H
 #define	BRANCHING_DISCRETE_H
 
+#include <cmath> // std::log, std::log1p
+#include <algorithm> // std::min
+#include <limits> // std::numeric_limits
+#include <vector> // std::vector
+#include <atomic> // std::atomic
+#include <functional> // std::bind
+
+#include <boost/cstdint.hpp> // boost::uint64_t
+#include <boost/shared_ptr.hpp> // boost::shared_ptr
+#include <boost/type_traits/integral_constant.hpp> // boost::true_type, boost::false_type
+
 #include <boost/assign/list_of.hpp> // boost::assign::list_of()
 
 #include <mutation_accumulation/parameters/parameters_fwd.h> // Symmetry, etc
 #include <mutation_accumulation/array/array2D.h> // array::Array2D
 #include <mutation_accumulation/random/multinomial_distribution.h> // mutation_accumulation::random::multinomial_distribution
 #include <mutation_accumulation/utility/configuration_traits.h> // configuration_types::branching_type etc
+#include <mutation_accumulation/utility/worker_pool.h> // workers::Worker_Pool
+#include <mutation_accumulation/simulation/seeding_policy.h> // monte_carlo::SplitMix64_Stream
 
 #include "configuration.h" // monte_carlo::Configuration
 #include "mutation_rates.h" // monte_carlo::MutationRates
@@ -20,6 +33,121 @@ namespace monte_carlo {
         /* time is discrete */
         typedef int time_type;
 
+        /**
+         * draw 64 random bits from an engine whose results are 64 bits wide
+         */
+        inline const boost::uint64_t draw_64_bits(base_generator_type &base_rand_gen, boost::true_type) {
+
+            return static_cast<boost::uint64_t> (base_rand_gen());
+        }
+
+        /**
+         * draw 64 random bits from an engine whose results are 32 bits wide, by combining two draws
+         */
+        inline const boost::uint64_t draw_64_bits(base_generator_type &base_rand_gen, boost::false_type) {
+
+            const boost::uint64_t high = static_cast<boost::uint64_t> (base_rand_gen());
+            const boost::uint64_t low = static_cast<boost::uint64_t> (base_rand_gen());
+
+            return (high << 32) | low;
+        }
+
+        /**
+         * draw 64 random bits, with as many draws as the width of base_generator_type requires (tag dispatch)
+         */
+        inline const boost::uint64_t draw_64_bits(base_generator_type &base_rand_gen) {
+
+            typedef boost::integral_constant<bool, (std::numeric_limits<base_generator_type::result_type>::digits >= 64) > is_64_bit;
+
+            return draw_64_bits(base_rand_gen, is_64_bit());
+        }
+
+        /**
+         * calculate probabilities of a cell division of a type-spe cell lying in reaction category 0 - 4: \n
+         * 0: symmetric renewal without mutation; 1: symmetric renewal in which one daughter mutates; \n
+         * 2: asymmetric division without mutation; 3: asymmetric division in which the renewed daughter mutates; \n
+         * 4: symmetric differentiation \n
+         * cells of the last species only divide asymmetrically \n
+         * non-member function so that exact solvers (see Branching_PGF) share the model with the stochastic process
+         */
+        inline const std::vector<double> categorical_probabilities(
+                const int &spe,
+                const int &number_species,
+                const MutationRates &uu,
+                const Symmetry &ss,
+                const SymmetricRenewal &rr) {
+
+            if ((spe >= 0) && (spe < (number_species - 1))) {
+
+                const double p0 = rr.value() * ss.value() * (1.0 - 2.0 * uu.at(spe));
+                const double p1 = rr.value() * ss.value() * 2.0 * uu.at(spe);
+                const double p2 = (1.0 - ss.value()) * (1.0 - uu.at(spe));
+                const double p3 = (1.0 - ss.value()) * uu.at(spe);
+                const double p4 = (1.0 - rr.value()) * ss.value();
+
+                return boost::assign::list_of(p0) (p1) (p2) (p3) (p4);
+
+            } else if (spe == (number_species - 1)) {
+
+                const double p0 = 0.0;
+                const double p1 = 0.0;
+                const double p2 = 1.0;
+                const double p3 = 0.0;
+                const double p4 = 0.0;
+
+                return boost::assign::list_of(p0) (p1) (p2) (p3) (p4);
+
+            } else {
+
+                assert(false);
+            }
+        }
+
+        /**
+         * log probability that a single cell of each species below spe has no type-spe descendant, after each of 0 ... time_span generations \n
+         * element (tt, jj) of the returned table \n
+         * cells divide independently, so the probability q_jj(tt) obeys q_jj(tt + 1) = f_jj(q(tt)), where f_jj is the offspring \n
+         * probability-generating function of categorical_probabilities(..), q_spe = 0 and q_jj(0) = 1; \n
+         * iterates the complements e = 1 - q, so that small probabilities keep their precision
+         */
+        inline const std::vector<std::vector<double> > log_no_descendant(
+                const int &spe,
+                const int &number_species,
+                const MutationRates &uu,
+                const Symmetry &ss,
+                const SymmetricRenewal &rr,
+                const int &time_span) {
+
+            std::vector<std::vector<double> > probabilities_categorical;
+            for (int jj = 0; jj < spe; jj++)
+                probabilities_categorical.push_back(categorical_probabilities(jj, number_species, uu, ss, rr));
+
+            std::vector<double> ee(spe + 1, 0.0); // e_jj = 1 - q_jj
+            ee.at(spe) = 1.0;
+
+            std::vector<std::vector<double> > log_qq(time_span + 1, std::vector<double>(spe, 0.0));
+            for (int tt = 1; tt <= time_span; tt++) {
+
+                std::vector<double> ee_next(ee);
+                for (int jj = 0; jj < spe; jj++) {
+                    const std::vector<double> &pp = probabilities_categorical.at(jj);
+                    const double ee_jj = ee.at(jj);
+                    const double ee_mutant = ee.at(jj + 1);
+                    ee_next.at(jj) =
+                            pp.at(0) * ee_jj * (2.0 - ee_jj) +
+                            pp.at(1) * (ee_jj + ee_mutant - ee_jj * ee_mutant) +
+                            pp.at(2) * ee_jj +
+                            pp.at(3) * ee_mutant;
+                }
+                ee = ee_next;
+
+                for (int jj = 0; jj < spe; jj++)
+                    log_qq.at(tt).at(jj) = std::log1p(-ee.at(jj));
+            }
+
+            return log_qq;
+        }
+
         /**
          * contains state of a branching process in discrete time
          */
@@ -40,43 +168,37 @@ namespace monte_carlo {
             const Symmetry _ss;
             const SymmetricRenewal _rr;
 
-        private:
-
-            /**
-             * calculate probabilities of a cell division lying in reaction category 0 - 4
-             */
-            const std::vector<double> calculate_categorical_probabilities(const int &spe) const {
-
-                if ((spe >= 0) && (spe < (this->number_species() - 1))) { // item 43 in "Effective C++: 55 Specific Ways to Improve Your Programs and Designs"
-
-                    const double p0 = _rr.value() * _ss.value() * (1.0 - 2.0 * _uu.at(spe));
-                    const double p1 = _rr.value() * _ss.value() * 2.0 * _uu.at(spe);
-                    const double p2 = (1.0 - _ss.value()) * (1.0 - _uu.at(spe));
-                    const double p3 = (1.0 - _ss.value()) * _uu.at(spe);
-                    const double p4 = (1.0 - _rr.value()) * _ss.value();
+            /* mutation rates with which the process is simulated (importance sampling) */
+            const MutationRates _uu_sampling;
+            const bool _tilted;
 
-                    return boost::assign::list_of(p0) (p1) (p2) (p3) (p4);
+            /* sub-populations that are no longer updated (see freeze(..)) */
+            std::vector<bool> _frozen;
 
-                } else if (spe == (this->number_species() - 1)) {
+            /* number of threads that update sub-populations, each from its own random stream; zero means a single shared stream \n
+             * (see update_sub_pops_in_parallel(..)) */
+            int _sub_pop_threads;
 
-                    const double p0 = 0.0;
-                    const double p1 = 0.0;
-                    const double p2 = 1.0;
-                    const double p3 = 0.0;
-                    const double p4 = 0.0;
+            /* threads that draw the divisions of sub-populations, created once by update_sub_pops_in_parallel(..) \n
+             * and shared by copies of this configuration, so that trials do not create threads in every generation */
+            boost::shared_ptr<workers::Worker_Pool> _sub_pop_workers;
 
-                    return boost::assign::list_of(p0) (p1) (p2) (p3) (p4);
+        private:
 
-                } else {
+            /**
+             * calculate probabilities of a cell division lying in reaction category 0 - 4, given mutation rates uu
+             */
+            const std::vector<double> calculate_categorical_probabilities(const int &spe, const MutationRates &uu) const {
 
-                    assert(false);
-                }
+                return categorical_probabilities(spe, this->number_species(), uu, _ss, _rr); // item 43 in "Effective C++: 55 Specific Ways to Improve Your Programs and Designs"
             }
 
             /**
-             * create a matrix to store the random number of times each reaction category occurs
+             * create a matrix to store the random number of times each reaction category occurs \n
+             * rand_gen is base_generator_type, or SplitMix64_Stream (see update_sub_pops_in_parallel(..))
              */
-            const array::Array2D<population_type> create_random_matrix(const int &pop, base_generator_type &base_rand_gen) const {
+            template <class generator_type>
+            const array::Array2D<population_type> create_random_matrix(const int &pop, generator_type &rand_gen) const {
 
                 /* create a matrix to store the random number of times each reaction category occurs for each species */
                 const int number_rxn_categories = 5;
@@ -89,13 +211,13 @@ namespace monte_carlo {
                     const population_type NN = this->get_population(Pop(pop), Spe(spe));
 
                     /* calculate probabilities of a cell division lying in reaction category 0 - 4 */
-                    const std::vector<double> probabilities = calculate_categorical_probabilities(spe);
+                    const std::vector<double> probabilities = calculate_categorical_probabilities(spe, _uu_sampling);
 
                     /* create multinomial_distribution object */
                     mutation_accumulation::random::multinomial_distribution<population_type, double> mn_rnd(NN, probabilities);
 
                     /* randomly choose how many times each reaction category occurs in this sub-population */
-                    std::vector<population_type> random_vector = mn_rnd(base_rand_gen);
+                    std::vector<population_type> random_vector = mn_rnd(rand_gen);
 
                     /* error catching */
                     assert(random_vector.size() == R_matrix.get_dim1());
@@ -111,6 +233,59 @@ namespace monte_carlo {
                 return R_matrix;
             }
 
+            /**
+             * log likelihood ratio of the numbers of divisions in each reaction category: \n
+             * sum over species and categories of n * log(p_nominal / p_sampling) \n
+             * (multinomial coefficients cancel)
+             */
+            const double log_likelihood_ratio(const array::Array2D<population_type> &R_matrix) const {
+
+                double log_ratio = 0.0;
+
+                for (int spe = 0; spe < R_matrix.get_dim0(); spe++) {
+
+                    const std::vector<double> probabilities_nominal = calculate_categorical_probabilities(spe, _uu);
+                    const std::vector<double> probabilities_sampling = calculate_categorical_probabilities(spe, _uu_sampling);
+
+                    for (int cat = 0; cat < R_matrix.get_dim1(); cat++) {
+                        if (R_matrix.at(spe, cat) == static_cast<population_type> (0)) continue;
+                        log_ratio += static_cast<double> (R_matrix.at(spe, cat)) * std::log(probabilities_nominal.at(cat) / probabilities_sampling.at(cat));
+                    }
+                }
+
+                return log_ratio;
+            }
+
+            /**
+             * add derivatives of log probability of the numbers of divisions in each reaction category, under nominal parameters: \n
+             * sum over categories of n * (dp / p), for the mutation rate of each species and for symmetry \n
+             * (the last species divides asymmetrically with certainty, so its divisions do not depend on the parameters and contribute nothing)
+             */
+            void add_score_of_divisions(const array::Array2D<population_type> &R_matrix) {
+
+                const double rr = _rr.value();
+                const double ss = _ss.value();
+                const int symmetry_parameter = _uu.size();
+
+                for (int spe = 0; spe < (R_matrix.get_dim0() - 1); spe++) {
+
+                    const double uu = _uu.at(spe);
+                    const std::vector<double> probabilities = calculate_categorical_probabilities(spe, _uu);
+
+                    /* derivatives of probabilities of reaction categories 0 - 4 (see calculate_categorical_probabilities) */
+                    const std::vector<double> dp_duu = boost::assign::list_of(-2.0 * rr * ss) (2.0 * rr * ss) (-(1.0 - ss)) (1.0 - ss) (0.0);
+                    const std::vector<double> dp_dss = boost::assign::list_of(rr * (1.0 - 2.0 * uu)) (2.0 * rr * uu) (-(1.0 - uu)) (-uu) (1.0 - rr);
+
+                    for (int cat = 0; cat < R_matrix.get_dim1(); cat++) {
+                        if (R_matrix.at(spe, cat) == static_cast<population_type> (0)) continue;
+                        if (!(probabilities.at(cat) > 0.0)) continue; // impossible under nominal parameters: path has zero likelihood ratio
+                        const double number_divisions = static_cast<double> (R_matrix.at(spe, cat));
+                        this->add_score(spe, number_divisions * dp_duu.at(cat) / probabilities.at(cat));
+                        this->add_score(symmetry_parameter, number_divisions * dp_dss.at(cat) / probabilities.at(cat));
+                    }
+                }
+            }
+
             /**
              * calculate contribution to spe sub-population from divisions of type-(spe-1) cells
              */
@@ -132,12 +307,15 @@ namespace monte_carlo {
             }
 
             /**
-             * update a single independent sub-population
+             * apply the random number of times each reaction category occurs for each species to a single sub-population
              */
-            void update_sub_population(const int &pop, base_generator_type &base_rand_gen) {
+            void apply_divisions(const int &pop, const array::Array2D<population_type> &R_matrix_pop) {
 
-                /* create a matrix to store the random number of times each reaction category occurs for each species */
-                array::Array2D<population_type> R_matrix_pop = create_random_matrix(pop, base_rand_gen);
+                /* weight tilted paths */
+                if (_tilted) this->add_log_likelihood_ratio(log_likelihood_ratio(R_matrix_pop));
+
+                /* differentiate log probability of path */
+                if (this->score_tracked()) add_score_of_divisions(R_matrix_pop);
 
                 /* update population sizes */
                 {
@@ -160,14 +338,72 @@ namespace monte_carlo {
 
             }
 
+            /**
+             * update a single independent sub-population
+             */
+            void update_sub_population(const int &pop, base_generator_type &base_rand_gen) {
+
+                /* draw the random number of times each reaction category occurs for each species, and apply it */
+                apply_divisions(pop, create_random_matrix(pop, base_rand_gen));
+
+            }
+
+            /**
+             * draw the divisions of every sub-population that is not frozen, \n
+             * sub-population pop from stream pop of the family labelled by key (see SplitMix64_Stream), \n
+             * on the threads of _sub_pop_workers
+             */
+            const std::vector<array::Array2D<population_type> > create_random_matrices(const boost::uint64_t &key) const {
+
+                std::vector<array::Array2D<population_type> > R_matrices(this->number_sub_pops());
+                std::atomic<int> next_pop(0);
+
+                /* worker body: claim sub-populations until none remain \n
+                 * workers only read populations, and write distinct elements of R_matrices */
+                struct Worker {
+
+                    static void run(const Branching_Discrete *configuration, const boost::uint64_t key, std::atomic<int> *next_pop, std::vector<array::Array2D<population_type> > *R_matrices) {
+
+                        for (int pop = (*next_pop)++; pop < configuration->number_sub_pops(); pop = (*next_pop)++) {
+
+                            if (configuration->_frozen.at(pop)) continue;
+
+                            SplitMix64_Stream sub_pop_rand_gen(key, pop);
+                            R_matrices->at(pop) = configuration->create_random_matrix(pop, sub_pop_rand_gen);
+                        }
+                    }
+                };
+
+                if (!_sub_pop_workers) {
+                    Worker::run(this, key, &next_pop, &R_matrices);
+                    return R_matrices;
+                }
+
+                _sub_pop_workers->run(std::bind(&Worker::run, this, key, &next_pop, &R_matrices));
+
+                return R_matrices;
+            }
+
             /**
              * update all sub-populations independently 
              */
             void update_populations(base_generator_type &base_rand_gen) {
 
-                /* update each sub-population independently */
+                /* update each sub-population independently, unless it is frozen */
+                if (_sub_pop_threads == 0) {
+                    for (int pop = 0; pop < this->number_sub_pops(); pop++)
+                        if (!_frozen.at(pop)) update_sub_population(pop, base_rand_gen);
+                    return;
+                }
+
+                /* label this generation's sub-population streams with 64 bits of the trajectory's stream, \n
+                 * so that trajectories remain a function of base_rand_gen alone (see Path_Policy_Base::record_success) */
+                const boost::uint64_t key = draw_64_bits(base_rand_gen);
+                const std::vector<array::Array2D<population_type> > R_matrices = create_random_matrices(key);
+
+                /* apply divisions in order of sub-population, so that likelihood ratio and score do not depend on the number of threads */
                 for (int pop = 0; pop < this->number_sub_pops(); pop++)
-                    update_sub_population(pop, base_rand_gen);
+                    if (!_frozen.at(pop)) apply_divisions(pop, R_matrices.at(pop));
 
             }
 
@@ -196,17 +432,134 @@ namespace monte_carlo {
         public:
 
             /**
-             * constructor
+             * accumulate derivatives of log probability of path with respect to each mutation rate and symmetry
+             */
+            virtual void track_score() {
+
+                this->start_score(_uu.size() + 1);
+            }
+
+            /**
+             * log probability that species spe does not arise in sub-population pop within the next number_generations generations, \n
+             * given its current populations, under the nominal parameters (see log_no_descendant) \n
+             * minus infinity if spe is present
+             */
+            const double log_probability_no_mutation(const Pop &pop, const Spe &spe, const int &number_generations) const {
+
+                if (this->get_population(pop, spe) > static_cast<population_type> (0))
+                    return -std::numeric_limits<double>::infinity();
+
+                const std::vector<double> log_qq = log_no_descendant(spe.value(), this->number_species(), _uu, _ss, _rr, number_generations).back();
+
+                double log_probability = 0.0;
+                for (int jj = 0; jj < spe.value(); jj++)
+                    log_probability += static_cast<double> (this->get_population(pop, Spe(jj))) * log_qq.at(jj);
+
+                return log_probability;
+            }
+
+            /**
+             * stop updating sub-population pop \n
+             * sub-populations evolve independently, so the others are unaffected; \n
+             * later divisions in a frozen sub-population would contribute factors of mean one to the likelihood ratio, \n
+             * and terms of mean zero to the score, so weighted statistics of decided fates remain unbiased
+             */
+            virtual void freeze(const Pop &pop) {
+
+                _frozen.at(pop.value()) = true;
+            }
+
+            /**
+             * true if sub-population pop is no longer updated
+             */
+            const bool frozen(const Pop &pop) const {
+
+                return _frozen.at(pop.value());
+            }
+
+            /**
+             * update sub-populations on up to number_threads threads \n
+             * each sub-population then draws its divisions in each generation from its own random stream, \n
+             * which depends only on the trajectory's stream, the generation and the sub-population, \n
+             * so results do not depend on number_threads (but differ from those of a single shared stream) \n
+             * worthwhile when sub-populations are many and large, and few long trajectories leave trial-level parallelism idle; \n
+             * zero restores the single shared stream \n
+             * the threads are created here, once, and shared by copies of this configuration, \n
+             * which therefore update their sub-populations one generation at a time
+             */
+            void update_sub_pops_in_parallel(const int &number_threads) {
+
+                assert(number_threads >= 0);
+                _sub_pop_threads = number_threads;
+
+                const int number_workers = std::min(_sub_pop_threads, this->number_sub_pops());
+                if (number_workers > 1) _sub_pop_workers.reset(new workers::Worker_Pool(number_workers));
+                else _sub_pop_workers.reset();
+            }
+
+            /**
+             * number of threads that update sub-populations; zero if sub-populations share a single random stream
+             */
+            const int sub_pop_threads() const {
+
+                return _sub_pop_threads;
+            }
+
+            /**
+             * true if the process is simulated with mutation rates other than the nominal ones (importance sampling)
+             */
+            const bool tilted() const {
+
+                return _tilted;
+            }
+
+            /**
+             * probabilities with which a division of a type-spe cell lies in reaction category 0 - 4, as simulated \n
+             * (see categorical_probabilities)
+             */
+            const std::vector<double> division_probabilities(const Spe &spe) const {
+
+                return calculate_categorical_probabilities(spe.value(), _uu_sampling);
+            }
+
+            /**
+             * change in the number of type-spe cells due to the divisions of type-spe cells, \n
+             * given the number of divisions in each reaction category: \n
+             * symmetric renewals add a cell; mutating asymmetric divisions and differentiations remove one
+             */
+            static const population_type change_from_current_species(const std::vector<population_type> &division_counts) {
+
+                return (division_counts.at(0) - division_counts.at(3) - division_counts.at(4));
+            }
+
+            /**
+             * change in the number of type-(spe+1) cells due to the divisions of type-spe cells: \n
+             * each division in which a daughter mutates adds a cell
+             */
+            static const population_type change_to_next_species(const std::vector<population_type> &division_counts) {
+
+                return (division_counts.at(1) + division_counts.at(3));
+            }
+
+            /**
+             * constructor \n
+             * if uu_sampling is given, the process is simulated with mutation rates uu_sampling instead of uu \n
+             * and each path is weighted by its likelihood ratio (importance sampling); \n
+             * uu_sampling must be positive wherever uu is
              */
             explicit Branching_Discrete(
                     const Population2D<population_type> &population2D,
                     const MutationRates &uu,
                     const Symmetry &ss,
                     const SymmetricRenewal &rr,
-                    const Uniform_Time_Grid<time_type> &time_grid)
-            : base_type(population2D, time_grid), _uu(uu), _ss(ss), _rr(rr) {
+                    const Uniform_Time_Grid<time_type> &time_grid,
+                    const MutationRates &uu_sampling = MutationRates())
+            : base_type(population2D, time_grid), _uu(uu), _ss(ss), _rr(rr),
+            _uu_sampling(uu_sampling.size() == 0 ? uu : uu_sampling), _tilted(uu_sampling.size() != 0),
+            _frozen(population2D.number_sub_pops(), false), _sub_pop_threads(0) {
 
                 assert(uu.size() == (population2D.number_species() - 1));
+                assert(valid_sampling_rates(_uu, _uu_sampling));
 
             }
 
@@ -0,0 +1,350 @@
+#ifndef BRANCHING_DISCRETE_GRAPH_H
+#define	BRANCHING_DISCRETE_GRAPH_H
+
+#include <vector> // std::vector
+#include <bitset> // std::bitset
+
+#include <boost/mpl/for_each.hpp> // boost::mpl::for_each
+#include <boost/mpl/size.hpp> // boost::mpl::size
+#include <boost/ref.hpp> // boost::ref
+#include <boost/random/binomial_distribution.hpp> // boost::random::binomial_distribution
+
+#include <mutation_accumulation/parameters/parameters_fwd.h> // Symmetry, etc
+#include <mutation_accumulation/utility/configuration_traits.h> // configuration_categories::branching_category
+
+#include "configuration.h" // monte_carlo::Configuration
+#include "mutation_rates.h" // monte_carlo::MutationRates
+#include "mutation_graph.h" // monte_carlo::Linear_Chain, monte_carlo::Diamond_Graph
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace branching_discrete_graph {
+
+        /* time is discrete */
+        typedef int time_type;
+
+        /**
+         * sources, targets and mutation rates of the edges of a mutation graph, in the order of Graph::edges
+         */
+        struct Edge_Table {
+            std::vector<int> sources;
+            std::vector<int> targets;
+            std::vector<int> rates;
+
+            /**
+             * called by boost::mpl::for_each once for each edge
+             */
+            template <class Edge>
+            void operator()(const Edge &) {
+
+                sources.push_back(Edge::source);
+                targets.push_back(Edge::target);
+                rates.push_back(Edge::rate);
+            }
+        };
+
+        /**
+         * branching process in discrete time, whose species mutate along the edges of the compile-time mutation graph Graph (see mutation_graph.h) \n
+         * a type-spe cell with m out-going edges divides into one of 3 + 2m reaction categories, in the order: \n
+         * symmetric renewal without mutation, symmetric renewal with a mutation along each edge, \n
+         * asymmetric division without mutation, asymmetric division with a mutation along each edge, \n
+         * symmetric differentiation \n
+         * species without out-going edges are not updated (as for the last species of Branching_Discrete) \n
+         * the reaction tables (categorical probabilities and update stencils) are built once, when the configuration is constructed \n
+         * records, in each sub-population, which edges yielded the first cell of their target species \n
+         * simulates Linear_Chain graphs directly, and implements Branching_Discrete_Diamond; \n
+         * Branching_Discrete and Branching_Discrete_Quadratic keep their own reaction tables, \n
+         * on which importance sampling, the score and Branching_PGF depend
+         */
+        template <class Graph, class population_type>
+        class Branching_Discrete_Graph : public Configuration<time_type, population_type> {
+        public:
+
+            typedef configuration_categories::branching_category category;
+
+            typedef Graph graph_type;
+
+            /**
+             * enum hack (Item 2)
+             */
+            enum {
+                number_edges = boost::mpl::size<typename Graph::edges>::value
+            };
+
+            typedef std::bitset<number_edges> route_type;
+
+        private:
+
+            typedef Configuration<time_type, population_type> base_type;
+
+            typedef std::bitset<Graph::number_species> species_set_type;
+
+        private:
+
+            /* probabilities required to implement update_populations_and_time(...) method */
+            const MutationRates _uu;
+            const Symmetry _ss;
+            const SymmetricRenewal _rr;
+
+            /* edges of Graph */
+            Edge_Table _edges;
+
+            /**
+             * _conditional_probabilities.at(spe).at(cat) = p_cat / (1 - p_0 - .. - p_{cat-1}), \n
+             * the binomial parameters that draw the number of type-spe divisions in each reaction category \n
+             * (computed exactly as in mutation_accumulation::random::multinomial_distribution)
+             */
+            std::vector<std::vector<double> > _conditional_probabilities;
+
+            /* update stencils: change in type-spe cells, and edge mutated along (or -1), per reaction category of spe */
+            std::vector<std::vector<population_type> > _self_changes;
+            std::vector<std::vector<int> > _category_edges;
+
+            /* _routes.at(pop).test(edge) indicates whether edge yielded the first cell of its target in sub-population pop */
+            std::vector<route_type> _routes;
+
+            /* species that have arisen by mutation in each sub-population */
+            std::vector<species_set_type> _arisen;
+
+            /* sub-populations that are no longer updated (see freeze(..)) */
+            std::vector<bool> _frozen;
+
+            /* work space for update_sub_population(..) */
+            std::vector<population_type> _changes;
+            std::vector<population_type> _mutants;
+
+        private:
+
+            /**
+             * edges leaving species spe, in the order of Graph::edges
+             */
+            const std::vector<int> out_edges(const int &spe) const {
+
+                std::vector<int> edges;
+                for (int edge = 0; edge < number_edges; edge++)
+                    if (_edges.sources.at(edge) == spe) edges.push_back(edge);
+
+                return edges;
+            }
+
+            /**
+             * calculate probabilities of a cell division of type-spe lying in each reaction category
+             */
+            const std::vector<double> calculate_categorical_probabilities(const std::vector<int> &edges) const {
+
+                double uu_total = 0.0;
+                for (int ii = 0; ii < edges.size(); ii++)
+                    uu_total += _uu.at(_edges.rates.at(edges.at(ii)));
+
+                std::vector<double> probabilities;
+
+                probabilities.push_back(_rr.value() * _ss.value() * (1.0 - 2.0 * uu_total));
+                for (int ii = 0; ii < edges.size(); ii++)
+                    probabilities.push_back(_rr.value() * _ss.value() * 2.0 * _uu.at(_edges.rates.at(edges.at(ii))));
+
+                probabilities.push_back((1.0 - _ss.value()) * (1.0 - uu_total));
+                for (int ii = 0; ii < edges.size(); ii++)
+                    probabilities.push_back((1.0 - _ss.value()) * _uu.at(_edges.rates.at(edges.at(ii))));
+
+                probabilities.push_back((1.0 - _rr.value()) * _ss.value());
+
+                return probabilities;
+            }
+
+            /**
+             * build categorical probabilities and update stencils of each species
+             */
+            void build_reaction_tables() {
+
+                for (int spe = 0; spe < Graph::number_species; spe++) {
+
+                    const std::vector<int> edges = out_edges(spe);
+                    const int mm = edges.size();
+
+                    if (mm == 0) continue;
+
+                    /* conditional probabilities */
+                    const std::vector<double> probabilities = calculate_categorical_probabilities(edges);
+                    double qq = 1.0;
+                    for (int cat = 0; cat < probabilities.size() - 1; cat++) {
+                        _conditional_probabilities.at(spe).push_back(probabilities.at(cat) / qq);
+                        qq -= probabilities.at(cat);
+                    }
+
+                    /* stencils */
+                    std::vector<population_type> &self_changes = _self_changes.at(spe);
+                    std::vector<int> &category_edges = _category_edges.at(spe);
+                    self_changes.assign(3 + 2 * mm, static_cast<population_type> (0));
+                    category_edges.assign(3 + 2 * mm, -1);
+
+                    self_changes.at(0) = static_cast<population_type> (1);
+                    for (int ii = 0; ii < mm; ii++) {
+                        self_changes.at(mm + 2 + ii) = static_cast<population_type> (-1);
+                        category_edges.at(1 + ii) = edges.at(ii);
+                        category_edges.at(mm + 2 + ii) = edges.at(ii);
+                    }
+                    self_changes.at(2 * mm + 2) = static_cast<population_type> (-1);
+                }
+            }
+
+            /**
+             * update a single independent sub-population \n
+             * species without cells are skipped, so they consume no random numbers
+             */
+            void update_sub_population(const int &pop, base_generator_type &base_rand_gen) {
+
+                typedef boost::random::binomial_distribution<population_type, double> binomial_distribution_type;
+
+                _changes.assign(Graph::number_species, static_cast<population_type> (0));
+                _mutants.assign(number_edges, static_cast<population_type> (0));
+
+                for (int spe = 0; spe < Graph::number_species; spe++) {
+
+                    const std::vector<double> &conditional_probabilities = _conditional_probabilities.at(spe);
+                    if (conditional_probabilities.empty()) continue;
+
+                    population_type NN = this->get_population(Pop(pop), Spe(spe));
+                    if (NN == static_cast<population_type> (0)) continue;
+
+                    const std::vector<population_type> &self_changes = _self_changes.at(spe);
+                    const std::vector<int> &category_edges = _category_edges.at(spe);
+
+                    /* randomly choose how many times each reaction category occurs (conditional method) */
+                    for (int cat = 0; cat < self_changes.size(); cat++) {
+
+                        const population_type zz = (cat < conditional_probabilities.size()) ?
+                                binomial_distribution_type(NN, conditional_probabilities.at(cat))(base_rand_gen) : NN;
+                        NN -= zz;
+
+                        _changes.at(spe) += self_changes.at(cat) * zz;
+                        if (category_edges.at(cat) >= 0) _mutants.at(category_edges.at(cat)) += zz;
+                    }
+                }
+
+                for (int edge = 0; edge < number_edges; edge++)
+                    _changes.at(_edges.targets.at(edge)) += _mutants.at(edge);
+
+                /* update population sizes */
+                for (int spe = 0; spe < Graph::number_species; spe++)
+                    if (_changes.at(spe) != static_cast<population_type> (0))
+                        set_population(Pop(pop), Spe(spe), this->get_population(Pop(pop), Spe(spe)) + _changes.at(spe));
+
+                /* record the edges that yielded the first cell of their target */
+                species_set_type &arisen = _arisen.at(pop);
+                for (int edge = 0; edge < number_edges; edge++)
+                    if ((_mutants.at(edge) > static_cast<population_type> (0)) && !arisen.test(_edges.targets.at(edge)))
+                        _routes.at(pop).set(edge);
+                for (int edge = 0; edge < number_edges; edge++)
+                    if (_mutants.at(edge) > static_cast<population_type> (0)) arisen.set(_edges.targets.at(edge));
+            }
+
+            /**
+             * update all sub-populations independently
+             */
+            void update_populations(base_generator_type &base_rand_gen) {
+
+                /* update each sub-population independently, unless it is frozen */
+                for (int pop = 0; pop < this->number_sub_pops(); pop++)
+                    if (!_frozen.at(pop)) update_sub_population(pop, base_rand_gen);
+
+            }
+
+            /**
+             * update time
+             */
+            void update_time() {
+
+                set_time(this->get_time() + static_cast<time_type> (1));
+
+            }
+
+            /**
+             * update populations and time
+             */
+            virtual void update_populations_and_time(base_generator_type &base_rand_gen) {
+
+                /* update all sub populations */
+                update_populations(base_rand_gen);
+
+                /* update time */
+                update_time();
+
+            }
+
+        public:
+
+            /**
+             * stop updating sub-population pop \n
+             * sub-populations evolve independently, so the others are unaffected
+             */
+            virtual void freeze(const Pop &pop) {
+
+                _frozen.at(pop.value()) = true;
+            }
+
+            /**
+             * constructor \n
+             * assumes that Population2D has Graph::number_species species, and that MutationRates has Graph::number_rates rates \n
+             * importance sampling (uu_sampling) is not implemented for this configuration
+             */
+            explicit Branching_Discrete_Graph(
+                    const Population2D<population_type> &population2D,
+                    const MutationRates &uu,
+                    const Symmetry &ss,
+                    const SymmetricRenewal &rr,
+                    const Uniform_Time_Grid<time_type> &time_grid,
+                    const MutationRates &uu_sampling = MutationRates())
+            : base_type(population2D, time_grid), _uu(uu), _ss(ss), _rr(rr),
+            _conditional_probabilities(Graph::number_species),
+            _self_changes(Graph::number_species),
+            _category_edges(Graph::number_species),
+            _routes(population2D.number_sub_pops()),
+            _arisen(population2D.number_sub_pops()),
+            _frozen(population2D.number_sub_pops(), false) {
+
+                assert(population2D.number_species() == Graph::number_species);
+                assert(uu.size() == Graph::number_rates);
+
+                if (uu_sampling.size() != 0) {
+                    std::cerr << "importance sampling is not implemented for Branching_Discrete_Graph" << std::endl;
+                    assert(false);
+                }
+
+                boost::mpl::for_each<typename Graph::edges>(boost::ref(_edges));
+                build_reaction_tables();
+            }
+
+            /**
+             * edges that yielded the first cell of their target species in sub-population pop \n
+             * in a discrete branching process, several edges may yield their target in the same cell cycle
+             */
+            const route_type routes(const Pop &pop) const {
+
+                return _routes.at(pop.value());
+            }
+
+            /**
+             * query whether a mutation of a type-source cell yielded the first type-target cell in sub-population pop
+             */
+            const bool yielded(const Pop &pop, const Spe &source, const Spe &target) const {
+
+                for (int edge = 0; edge < number_edges; edge++)
+                    if ((_edges.sources.at(edge) == source.value()) && (_edges.targets.at(edge) == target.value()))
+                        return _routes.at(pop.value()).test(edge);
+
+                std::cerr << "no mutation from species " << source.value() << " to species " << target.value() << std::endl;
+                assert(false);
+                return false;
+            }
+
+        };
+
+    }
+
+    using branching_discrete_graph::Branching_Discrete_Graph;
+
+}
+
+#endif	/* BRANCHING_DISCRETE_GRAPH_H */
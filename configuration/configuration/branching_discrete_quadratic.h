@@ -1,6 +1,8 @@
 #ifndef BRANCHING_DISCRETE_QUADRATIC_H
 #define	BRANCHING_DISCRETE_QUADRATIC_H
 
+#include <vector> // std::vector
+
 #include <boost/assign/list_of.hpp> // boost::assign::list_of()
 
 #include <mutation_accumulation/parameters/parameters_fwd.h> // Symmetry, etc
@@ -41,6 +43,9 @@ namespace monte_carlo {
             const Symmetry _ss;
             const SymmetricRenewal _rr;
 
+            /* sub-populations that are no longer updated (see freeze(..)) */
+            std::vector<bool> _frozen;
+
         private:
 
             /**
@@ -170,9 +175,9 @@ namespace monte_carlo {
              */
             void update_populations(base_generator_type &base_rand_gen) {
 
-                /* update each sub-population independently */
+                /* update each sub-population independently, unless it is frozen */
                 for (int pop = 0; pop < this->number_sub_pops(); pop++)
-                    update_sub_population(pop, base_rand_gen);
+                    if (!_frozen.at(pop)) update_sub_population(pop, base_rand_gen);
 
             }
 
@@ -201,18 +206,35 @@ namespace monte_carlo {
         public:
 
             /**
-             * constructor
+             * stop updating sub-population pop \n
+             * sub-populations evolve independently, so the others are unaffected
+             */
+            virtual void freeze(const Pop &pop) {
+
+                _frozen.at(pop.value()) = true;
+            }
+
+            /**
+             * constructor \n
+             * importance sampling (uu_sampling) is not implemented for this configuration
              */
             explicit Branching_Discrete_Quadratic(
                     const Population2D<population_type> &population2D,
                     const MutationRates &uu,
                     const Symmetry &ss,
                     const SymmetricRenewal &rr,
-                    const Uniform_Time_Grid<time_type> &time_grid)
-            : base_type(population2D, time_grid), _uu(uu), _ss(ss), _rr(rr) {
+                    const Uniform_Time_Grid<time_type> &time_grid,
+                    const MutationRates &uu_sampling = MutationRates())
+            : base_type(population2D, time_grid), _uu(uu), _ss(ss), _rr(rr),
+            _frozen(population2D.number_sub_pops(), false) {
 
                 assert(uu.size() == (population2D.number_species() - 1));
 
+                if (uu_sampling.size() != 0) {
+                    std::cerr << "importance sampling is not implemented for Branching_Discrete_Quadratic" << std::endl;
+                    assert(false);
+                }
+
             }
 
         };
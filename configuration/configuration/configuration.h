@@ -1,6 +1,11 @@
 #ifndef CONFIG_BASE_H
 #define	CONFIG_BASE_H
 
+#include <cmath> // std::exp
+#include <vector> // std::vector
+#include <iostream> // std::cerr
+#include <cassert> // assert
+
 #include <mutation_accumulation/utility/data_traits.h> // data_types::discrete_type, etc
 
 #include "configuration_interface.h" // monte_carlo::Configuration_Interface
@@ -38,6 +43,12 @@ namespace monte_carlo {
         typedef Path<time_type, population_type> path_t;
         path_t _path;
 
+        /* accumulated in logarithmic form, since the ratio is a product over many events */
+        double _log_likelihood_ratio;
+
+        /* derivatives of log probability of path (see score()); empty unless tracked */
+        std::vector<double> _score;
+
 
     private:
 
@@ -46,6 +57,23 @@ namespace monte_carlo {
          */
         virtual void update_populations_and_time(base_generator_type &base_rand_gen) = 0;
 
+        /**
+         * update extinction times, mutation times and path after populations and time have changed
+         */
+        void record_transition() {
+
+            /* update extinction times */
+            _extinction_times.update(_time, _population2D);
+
+            /* update mutation times */
+            _mutation_times.update(_time, _population2D);
+
+            /* update path */
+            typename data_types::data_traits<time_type>::category time_category;
+            update_path(time_category);
+
+        }
+
         /**
          * update path; discrete time
          */
@@ -78,7 +106,8 @@ namespace monte_carlo {
         _population2D_old(population2D),
         _extinction_times(population2D.number_sub_pops()),
         _mutation_times(population2D),
-        _path(path_t(population2D, time_grid)) {
+        _path(path_t(population2D, time_grid)),
+        _log_likelihood_ratio(0.0) {
 
         }
 
@@ -89,7 +118,7 @@ namespace monte_carlo {
          * this is an empty constructor\n
          * compiler should generate code to construct private data members (Item 30)
          */
-        explicit Configuration() {
+        explicit Configuration() : _log_likelihood_ratio(0.0) {
 
         }
 
@@ -101,6 +130,15 @@ namespace monte_carlo {
             _time = new_time;
         }
 
+        /**
+         * current populations of all sub-populations and species \n
+         * lets derived classes pass their state to non-member functions without copying it
+         */
+        const population2D_type &get_population2D() const {
+
+            return _population2D;
+        }
+
         /**
          * set number of type-spe cells in sub-population pop
          */
@@ -109,6 +147,40 @@ namespace monte_carlo {
             _population2D.at(pop.value(), spe.value()) = new_population_size;
         }
 
+        /**
+         * multiply likelihood ratio of path by exp(log_ratio) \n
+         * derived classes that simulate with tilted parameters call this for every random choice
+         */
+        void add_log_likelihood_ratio(const double &log_ratio) {
+
+            _log_likelihood_ratio += log_ratio;
+        }
+
+        /**
+         * start accumulating a score with number_parameters derivatives \n
+         * derived classes that can differentiate their transition probabilities call this from track_score()
+         */
+        void start_score(const int &number_parameters) {
+
+            _score.assign(number_parameters, 0.0);
+        }
+
+        /**
+         * true if score is accumulated
+         */
+        const bool score_tracked() const {
+
+            return !_score.empty();
+        }
+
+        /**
+         * add increment to derivative of log probability of path with respect to parameter
+         */
+        void add_score(const int &parameter, const double &increment) {
+
+            _score.at(parameter) += increment;
+        }
+
 
     public:
 
@@ -177,6 +249,14 @@ namespace monte_carlo {
             return _mutation_times(pop, spe);
         }
 
+        /**
+         * number of mutation times and extinction times recorded so far
+         */
+        virtual const int number_first_passages() const {
+
+            return _mutation_times.number_recorded() + _extinction_times.number_recorded();
+        }
+
         /**
          * get path time \n
          */
@@ -201,6 +281,24 @@ namespace monte_carlo {
             return _path.at(pop, spe, node);
         }
 
+        /**
+         * stream path populations to listener as nodes are crossed, rather than storing them \n
+         * must be called before the first transition
+         */
+        virtual void attach_node_listener(Node_Listener<population_type> * const listener) {
+
+            _path.attach_listener(listener);
+        }
+
+        /**
+         * fill the nodes that the trajectory has not reached with the current populations \n
+         * call only once the populations can no longer change, i.e. after the whole population has gone extinct
+         */
+        virtual void complete_path() {
+
+            _path.fill_remaining_nodes(_population2D);
+        }
+
         /**
          * transition to next state of stochastic process
          */
@@ -212,15 +310,27 @@ namespace monte_carlo {
             /* update populations and time */
             update_populations_and_time(base_rand_gen);
 
-            /* update extinction times */
-            _extinction_times.update(_time, _population2D);
+            /* update path-dependent data */
+            record_transition();
 
-            /* update mutation times */
-            _mutation_times.update(_time, _population2D);
+        }
 
-            /* update path */
-            typename data_types::data_traits<time_type>::category time_category;
-            update_path(time_category);
+        /**
+         * transition to populations new_population2D at time new_time, which were drawn elsewhere \n
+         * lets an engine that advances many trajectories in lockstep (see Generate_Statistics_Ensemble) \n
+         * draw the populations itself, while each trajectory keeps its own path-dependent data
+         */
+        void transition_to(const population2D_type &new_population2D, const time_type &new_time) {
+
+            /* store old value of population matrix before it is changed */
+            _population2D_old = _population2D;
+
+            /* update populations and time */
+            _population2D = new_population2D;
+            _time = new_time;
+
+            /* update path-dependent data */
+            record_transition();
 
         }
 
@@ -233,6 +343,38 @@ namespace monte_carlo {
 
         }
 
+        /**
+         * likelihood of path under nominal parameters relative to sampling parameters
+         */
+        virtual const double likelihood_ratio() const {
+
+            return std::exp(_log_likelihood_ratio);
+        }
+
+        /**
+         * by default, a configuration cannot differentiate its transition probabilities
+         */
+        virtual void track_score() {
+
+            std::cerr << "configuration does not accumulate a score" << std::endl;
+            assert(false);
+        }
+
+        /**
+         * derivatives of log probability of path under nominal parameters
+         */
+        virtual const std::vector<double> score() const {
+
+            return _score;
+        }
+
+        /**
+         * by default, every sub-population is updated until the end of the trajectory
+         */
+        virtual void freeze(const Pop &) {
+
+        }
+
 
 
     };
@@ -1,9 +1,12 @@
 #ifndef CONFIG_INTERFACE_H
 #define	CONFIG_INTERFACE_H
 
+#include <vector> // std::vector
+
 #include <mutation_accumulation/parameters/parameters_fwd.h> // monte_carlo::Pop, etc
 
 #include "random_fwd.h" // monte_carlo::base_generator_type
+#include "node_listener.h" // monte_carlo::Node_Listener
 
 /*************************************************************************/
 
@@ -79,6 +82,12 @@ namespace monte_carlo {
          */
         virtual const time_type mutation_times(const Pop &pop, const Spe & spe) const = 0;
 
+        /**
+         * number of mutation times and extinction times recorded so far \n
+         * changes only when a first passage occurs, so observers of first-passage data may skip transitions that leave it unchanged
+         */
+        virtual const int number_first_passages() const = 0;
+
         /**
          * get path time \n
          */
@@ -94,11 +103,50 @@ namespace monte_carlo {
          */
         virtual const population_type get_path_population(const Pop &pop, const Spe &spe, const Node &node) const = 0;
 
+        /**
+         * stream path populations to listener as nodes are crossed, rather than storing them \n
+         * must be called before the first transition
+         */
+        virtual void attach_node_listener(Node_Listener<population_type> * const listener) = 0;
+
+        /**
+         * fill the nodes that the trajectory has not reached with the current populations \n
+         * call only once the populations can no longer change, i.e. after the whole population has gone extinct
+         */
+        virtual void complete_path() = 0;
+
         /**
          * transition to next state of stochastic process
          */
         virtual void transition(base_generator_type &base_rand_gen) = 0; 
 
+        /**
+         * likelihood of the path so far under the nominal parameters, relative to its likelihood under the parameters it was simulated with \n
+         * equals one unless the process is simulated with tilted parameters (importance sampling); \n
+         * weighting each trial by this ratio makes averages over tilted paths unbiased estimates of nominal averages
+         */
+        virtual const double likelihood_ratio() const = 0;
+
+        /**
+         * accumulate the score of the path, i.e. the derivative of its log probability under the nominal parameters \n
+         * with respect to each mutation rate and to the symmetry (see score()) \n
+         * must be called before the first transition; copies of the configuration keep accumulating
+         */
+        virtual void track_score() = 0;
+
+        /**
+         * score of the path so far: one derivative per mutation rate, in order, followed by the derivative with respect to symmetry \n
+         * empty unless track_score() was called; \n
+         * averaging fate * score over trials estimates the derivative of the probability of the fate (likelihood-ratio method)
+         */
+        virtual const std::vector<double> score() const = 0;
+
+        /**
+         * stop updating sub-population pop, whose fate has been decided (see Path_Policy_Base::freeze_decided) \n
+         * configurations whose sub-populations do not evolve independently may ignore the request
+         */
+        virtual void freeze(const Pop &pop) = 0;
+
 
         /**
          * determine if end of trajectory has been reached
@@ -24,13 +24,16 @@ namespace monte_carlo {
          **/
         std::vector<time_type> _extinction_times;
 
+        /* number of extinctions recorded so far */
+        int _number_recorded;
+
 
     public:
         
         /**
          * custom constructor
          */
-        explicit ExtinctionTimes(const int &number_sub_pops) {
+        explicit ExtinctionTimes(const int &number_sub_pops) : _number_recorded(0) {
 
             _extinction_times = std::vector<time_type>(number_sub_pops, static_cast<time_type>(-1));
 
@@ -47,9 +50,19 @@ namespace monte_carlo {
                 if (_extinction_times.at(pop) < static_cast<time_type>(0)) // if an extinction has not been recorded ...
 
                     if (sub_pop_size(population2D, Pop(pop)) == static_cast<population_type>(0)) // if an extinction has actually occurred ...
-
+                    {
                         _extinction_times.at(pop) = tt; // record the extinction
+                        _number_recorded++;
+                    }
+
+        }
+
+        /**
+         * number of extinctions recorded so far
+         */
+        const int number_recorded() const {
 
+            return _number_recorded;
         }
 
 
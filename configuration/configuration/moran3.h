@@ -100,17 +100,29 @@ namespace monte_carlo {
                 return mutationRates_4species;
             }
 
+            /**
+             * convert sampling mutation rates, which are absent (empty) if the process is not tilted
+             */
+            static const MutationRates convert_3Species_to_4Species_sampling(const MutationRates &mutationRates_3species) {
+
+                if (mutationRates_3species.size() == 0) return MutationRates();
+
+                return convert_3Species_to_4Species(mutationRates_3species);
+            }
+
         public:
 
             /**
-             * constructor
+             * constructor \n
+             * if uu_sampling is given, the process is simulated with mutation rates uu_sampling instead of uu (see Moran5)
              */
             explicit Moran3(
                     const population2D_type &population2D,
                     const MutationRates &uu,
                     const Symmetry &ss,
-                    const Uniform_Time_Grid<time_type> &time_grid)
-            : _moran4(convert_3Species_to_4Species(population2D), convert_3Species_to_4Species(uu), ss, time_grid) {
+                    const Uniform_Time_Grid<time_type> &time_grid,
+                    const MutationRates &uu_sampling = MutationRates())
+            : _moran4(convert_3Species_to_4Species(population2D), convert_3Species_to_4Species(uu), ss, time_grid, convert_3Species_to_4Species_sampling(uu_sampling)) {
 
 #ifdef DEBUG_MORAN3_H
                 moran3_utility::debug_print(convert_3Species_to_4Species(population2D));
@@ -175,6 +187,14 @@ namespace monte_carlo {
                 return _moran4.mutation_times(pop, spe);
             }
 
+            /**
+             * number of mutation times and extinction times recorded so far
+             */
+            virtual const int number_first_passages() const {
+
+                return _moran4.number_first_passages();
+            }
+
             /**
              * get path time \n
              */
@@ -199,6 +219,22 @@ namespace monte_carlo {
                 return _moran4.get_path_population(pop, spe, node);
             }
 
+            /**
+             * stream path populations to listener as nodes are crossed \n
+             */
+            virtual void attach_node_listener(Node_Listener<population_type> * const listener) {
+
+                _moran4.attach_node_listener(listener);
+            }
+
+            /**
+             * fill the nodes that the trajectory has not reached with the current populations \n
+             */
+            virtual void complete_path() {
+
+                _moran4.complete_path();
+            }
+
             /**
              * transition to next state of stochastic process
              */
@@ -216,6 +252,43 @@ namespace monte_carlo {
 
             }
 
+            /**
+             * likelihood of path under nominal parameters relative to sampling parameters
+             */
+            virtual const double likelihood_ratio() const {
+
+                return _moran4.likelihood_ratio();
+            }
+
+            /**
+             * accumulate score (see Moran5)
+             */
+            virtual void track_score() {
+
+                _moran4.track_score();
+            }
+
+            /**
+             * stop updating sub-population pop (see Moran4)
+             */
+            virtual void freeze(const Pop &pop) {
+
+                _moran4.freeze(pop);
+            }
+
+            /**
+             * score of Moran4 without the derivative with respect to the padding mutation rate
+             */
+            virtual const std::vector<double> score() const {
+
+                const std::vector<double> score_padded = _moran4.score();
+                if (score_padded.empty()) return score_padded;
+
+                std::vector<double> score_3Species(score_padded.begin(), score_padded.end() - 2); // mutation rates
+                score_3Species.push_back(score_padded.back()); // symmetry
+                return score_3Species;
+            }
+
 
         };
 
@@ -5,6 +5,9 @@
 #include <boost/random/variate_generator.hpp> // variate_generator
 #include <boost/random/exponential_distribution.hpp> // exponential_distribution
 
+#include <cmath> // std::log
+#include <vector> // std::vector
+
 #include <mutation_accumulation/parameters/parameters_fwd.h> // Symmetry, etc
 #include <mutation_accumulation/array/array4D.h> // array::Array4D
 #include <mutation_accumulation/utility/configuration_traits.h> // configuration_types::branching_type etc
@@ -15,6 +18,7 @@
 #endif
 
 #include "configuration.h" // monte_carlo::Configuration
+#include "population2D.h" // monte_carlo::Population2D
 #include "mutation_rates.h" // monte_carlo::MutationRates
 
 /*************************************************************************/
@@ -27,188 +31,201 @@ namespace monte_carlo {
         typedef double time_type;
 
         /**
-         * accumulation of four mutations (5 stages) in a Moran process \n
-         * requires four mutation rates\n
-         * can be used to study accumulation of fewer mutations by stopping process once the appropriate stem cell has arisen\n
+         * calculate "marginal" transition rates in state nn, given mutation rates uu, symmetry ss and total population size NN \n
+         * element (j, k, i, l) is the rate at which a stage-k cell in sub-population j is converted to a stage-l cell in sub-population i \n
+         * non-member function so that exact solvers (see Moran_Master_Equation) share the model with the stochastic process
          */
         template <class population_type>
-        class Moran5 : public Configuration<time_type, population_type> {
-        public:
-
-            typedef configuration_categories::moran_category category;
+        const array::Array4D<double> transition_rates(const Population2D<population_type> &nn, const MutationRates &uu, const double &ss, const long long int &NN) {
+
+            // all elements initialized to zero
+            array::Array4D<double> ww(
+                    nn.number_sub_pops(),
+                    4,
+                    nn.number_sub_pops(),
+                    5);
+
+            /* 
+             * jk -> il means that a stage-k cell in the jth sub-population
+             * is converted to a stage-l cell in the ith sub-population
+             */
+            for (int pop_dec = 0; pop_dec < nn.number_sub_pops(); pop_dec++)
+                for (int pop_inc = 0; pop_inc < nn.number_sub_pops(); pop_inc++) {
 
-        private:
+                    { // j0 -> i0
+                        if (pop_dec != pop_inc) {
+                            ww.at(pop_dec, 0, pop_inc, 0) = 0.5 * ss * nn.at(pop_inc, 0) * (1.0 - 2.0 * uu.at(0)) * nn.at(pop_dec, 0) / (double) NN;
+                        }
+                    }
 
-            typedef Configuration<time_type, population_type> base_type;
+                    { // j0 -> i1
+                        const double lambda_sm = ss * nn.at(pop_inc, 0) * uu.at(0) * nn.at(pop_dec, 0) / (double) NN;
+                        double lambda_am = 0.0;
+                        if (pop_dec == pop_inc)
+                            lambda_am = (1.0 - ss) * nn.at(pop_inc, 0) * uu.at(0);
+                        const double lambda_s = 0.5 * ss * nn.at(pop_inc, 1) * (1.0 - 2.0 * uu.at(1)) * nn.at(pop_dec, 0) / (double) NN;
+                        ww.at(pop_dec, 0, pop_inc, 1) = lambda_sm + lambda_am + lambda_s;
+                    }
 
-        private:
+                    { // j0 -> i2
+                        const double lambda_sm = ss * nn.at(pop_inc, 1) * uu.at(1) * nn.at(pop_dec, 0) / (double) NN;
+                        const double lambda_s = 0.5 * ss * nn.at(pop_inc, 2) * (1.0 - 2.0 * uu.at(2)) * nn.at(pop_dec, 0) / (double) NN;
+                        ww.at(pop_dec, 0, pop_inc, 2) = lambda_sm + lambda_s;
+                    }
 
-            /* probabilities required to implement update_populations_and_time(...) method */
-            const MutationRates _uu;
-            const Symmetry _ss;
+                    { // j0 -> i3
+                        const double lambda_sm = ss * nn.at(pop_inc, 2) * uu.at(2) * nn.at(pop_dec, 0) / (double) NN;
+                        const double lambda_s = 0.5 * ss * nn.at(pop_inc, 3) * (1.0 - 2.0 * uu.at(3)) * nn.at(pop_dec, 0) / (double) NN;
+                        ww.at(pop_dec, 0, pop_inc, 3) = lambda_sm + lambda_s;
+                    }
 
-            const long long int _NN; // total population size (constant in time)
+                    { // j0 -> i4
+                        ww.at(pop_dec, 0, pop_inc, 4) = ss * nn.at(pop_inc, 3) * uu.at(3) * nn.at(pop_dec, 0) / (double) NN;
+                    }
 
-        private:
+                    { // j1 -> i0
+                        ww.at(pop_dec, 1, pop_inc, 0) = 0.5 * ss * nn.at(pop_inc, 0) * (1.0 - 2.0 * uu.at(0)) * nn.at(pop_dec, 1) / (double) NN;
+                    }
 
-            /**
-             * fetch current population size of stage-spe cells in sub-population pop
-             */
-            const population_type nn(const int &pop, const int &spe) const {
+                    { // j1 -> i1
+                        if (pop_dec != pop_inc) {
+                            const double lambda_sm = ss * nn.at(pop_inc, 0) * uu.at(0) * nn.at(pop_dec, 1) / (double) NN;
+                            const double lambda_s = 0.5 * ss * nn.at(pop_inc, 1) * (1.0 - 2.0 * uu.at(1)) * nn.at(pop_dec, 1) / (double) NN;
+                            ww.at(pop_dec, 1, pop_inc, 1) = lambda_sm + lambda_s;
+                        }
+                    }
 
-                return this->get_population(Pop(pop), Spe(spe));
-            }
+                    { // j1 -> i2
+                        const double lambda_sm = ss * nn.at(pop_inc, 1) * uu.at(1) * nn.at(pop_dec, 1) / (double) NN;
+                        double lambda_am = 0.0;
+                        if (pop_dec == pop_inc)
+                            lambda_am = (1.0 - ss) * nn.at(pop_inc, 1) * uu.at(1);
+                        const double lambda_s = 0.5 * ss * nn.at(pop_inc, 2) * (1.0 - 2.0 * uu.at(2)) * nn.at(pop_dec, 1) / (double) NN;
+                        ww.at(pop_dec, 1, pop_inc, 2) = lambda_sm + lambda_am + lambda_s;
+                    }
 
-            /**
-             * calculate "marginal" transition rates given the current state
-             */
-            const array::Array4D<double> compute_transition_rates() const {
+                    { // j1 -> i3
+                        const double lambda_sm = ss * nn.at(pop_inc, 2) * uu.at(2) * nn.at(pop_dec, 1) / (double) NN;
+                        const double lambda_s = 0.5 * ss * nn.at(pop_inc, 3) * (1.0 - 2.0 * uu.at(3)) * nn.at(pop_dec, 1) / (double) NN;
+                        ww.at(pop_dec, 1, pop_inc, 3) = lambda_sm + lambda_s;
+                    }
 
-                // all elements initialized to zero
-                array::Array4D<double> ww(
-                        this->number_sub_pops(),
-                        4,
-                        this->number_sub_pops(),
-                        5);
+                    { // j1 -> i4
+                        ww.at(pop_dec, 1, pop_inc, 4) = ss * nn.at(pop_inc, 3) * uu.at(3) * nn.at(pop_dec, 1) / (double) NN;
+                    }
 
-                const double ss = _ss.value();
+                    { // j2 -> i0
+                        ww.at(pop_dec, 2, pop_inc, 0) = 0.5 * ss * nn.at(pop_inc, 0) * (1.0 - 2.0 * uu.at(0)) * nn.at(pop_dec, 2) / (double) NN;
+                    }
 
-                /* 
-                 * jk -> il means that a stage-k cell in the jth sub-population
-                 * is converted to a stage-l cell in the ith sub-population
-                 */
-                for (int pop_dec = 0; pop_dec < this->number_sub_pops(); pop_dec++)
-                    for (int pop_inc = 0; pop_inc < this->number_sub_pops(); pop_inc++) {
+                    { // j2 -> i1
+                        const double lambda_sm = ss * nn.at(pop_inc, 0) * uu.at(0) * nn.at(pop_dec, 2) / (double) NN;
+                        const double lambda_s = 0.5 * ss * nn.at(pop_inc, 1) * (1.0 - 2.0 * uu.at(1)) * nn.at(pop_dec, 2) / (double) NN;
+                        ww.at(pop_dec, 2, pop_inc, 1) = lambda_sm + lambda_s;
+                    }
 
-                        { // j0 -> i0
-                            if (pop_dec != pop_inc) {
-                                ww.at(pop_dec, 0, pop_inc, 0) = 0.5 * ss * nn(pop_inc, 0) * (1.0 - 2.0 * _uu.at(0)) * nn(pop_dec, 0) / (double) _NN;
-                            }
+                    { // j2 -> i2
+                        if (pop_dec != pop_inc) {
+                            const double lambda_sm = ss * nn.at(pop_inc, 1) * uu.at(1) * nn.at(pop_dec, 2) / (double) NN;
+                            const double lambda_s = 0.5 * ss * nn.at(pop_inc, 2) * (1.0 - 2.0 * uu.at(2)) * nn.at(pop_dec, 2) / (double) NN;
+                            ww.at(pop_dec, 2, pop_inc, 2) = lambda_sm + lambda_s;
                         }
+                    }
 
-                        { // j0 -> i1
-                            const double lambda_sm = ss * nn(pop_inc, 0) * _uu.at(0) * nn(pop_dec, 0) / (double) _NN;
-                            double lambda_am = 0.0;
-                            if (pop_dec == pop_inc)
-                                lambda_am = (1.0 - ss) * nn(pop_inc, 0) * _uu.at(0);
-                            const double lambda_s = 0.5 * ss * nn(pop_inc, 1) * (1.0 - 2.0 * _uu.at(1)) * nn(pop_dec, 0) / (double) _NN;
-                            ww.at(pop_dec, 0, pop_inc, 1) = lambda_sm + lambda_am + lambda_s;
-                        }
+                    { // j2 -> i3
+                        const double lambda_sm = ss * nn.at(pop_inc, 2) * uu.at(2) * nn.at(pop_dec, 2) / (double) NN;
+                        double lambda_am = 0.0;
+                        if (pop_dec == pop_inc)
+                            lambda_am = (1.0 - ss) * nn.at(pop_inc, 2) * uu.at(2);
+                        const double lambda_s = 0.5 * ss * nn.at(pop_inc, 3) * (1.0 - 2.0 * uu.at(3)) * nn.at(pop_dec, 2) / (double) NN;
+                        ww.at(pop_dec, 2, pop_inc, 3) = lambda_sm + lambda_am + lambda_s;
+                    }
 
-                        { // j0 -> i2
-                            const double lambda_sm = ss * nn(pop_inc, 1) * _uu.at(1) * nn(pop_dec, 0) / (double) _NN;
-                            const double lambda_s = 0.5 * ss * nn(pop_inc, 2) * (1.0 - 2.0 * _uu.at(2)) * nn(pop_dec, 0) / (double) _NN;
-                            ww.at(pop_dec, 0, pop_inc, 2) = lambda_sm + lambda_s;
-                        }
+                    { // j2 -> i4
+                        ww.at(pop_dec, 2, pop_inc, 4) = ss * nn.at(pop_inc, 3) * uu.at(3) * nn.at(pop_dec, 2) / (double) NN;
+                    }
 
-                        { // j0 -> i3
-                            const double lambda_sm = ss * nn(pop_inc, 2) * _uu.at(2) * nn(pop_dec, 0) / (double) _NN;
-                            const double lambda_s = 0.5 * ss * nn(pop_inc, 3) * (1.0 - 2.0 * _uu.at(3)) * nn(pop_dec, 0) / (double) _NN;
-                            ww.at(pop_dec, 0, pop_inc, 3) = lambda_sm + lambda_s;
-                        }
+                    { // j3 -> i0
+                        ww.at(pop_dec, 3, pop_inc, 0) = 0.5 * ss * nn.at(pop_inc, 0) * (1.0 - 2.0 * uu.at(0)) * nn.at(pop_dec, 3) / (double) NN;
+                    }
 
-                        { // j0 -> i4
-                            ww.at(pop_dec, 0, pop_inc, 4) = ss * nn(pop_inc, 3) * _uu.at(3) * nn(pop_dec, 0) / (double) _NN;
-                        }
+                    { // j3 -> i1
+                        const double lambda_sm = ss * nn.at(pop_inc, 0) * uu.at(0) * nn.at(pop_dec, 3) / (double) NN;
+                        const double lambda_s = 0.5 * ss * nn.at(pop_inc, 1) * (1.0 - 2.0 * uu.at(1)) * nn.at(pop_dec, 3) / (double) NN;
+                        ww.at(pop_dec, 3, pop_inc, 1) = lambda_sm + lambda_s;
+                    }
 
-                        { // j1 -> i0
-                            ww.at(pop_dec, 1, pop_inc, 0) = 0.5 * ss * nn(pop_inc, 0) * (1.0 - 2.0 * _uu.at(0)) * nn(pop_dec, 1) / (double) _NN;
-                        }
+                    { // j3 -> i2
+                        const double lambda_s = 0.5 * ss * nn.at(pop_inc, 2) * (1.0 - 2.0 * uu.at(2)) * nn.at(pop_dec, 3) / (double) NN;
+                        const double lambda_sm = ss * nn.at(pop_inc, 1) * uu.at(1) * nn.at(pop_dec, 3) / (double) NN;
+                        ww.at(pop_dec, 3, pop_inc, 2) = lambda_sm + lambda_s;
+                    }
 
-                        { // j1 -> i1
-                            if (pop_dec != pop_inc) {
-                                const double lambda_sm = ss * nn(pop_inc, 0) * _uu.at(0) * nn(pop_dec, 1) / (double) _NN;
-                                const double lambda_s = 0.5 * ss * nn(pop_inc, 1) * (1.0 - 2.0 * _uu.at(1)) * nn(pop_dec, 1) / (double) _NN;
-                                ww.at(pop_dec, 1, pop_inc, 1) = lambda_sm + lambda_s;
-                            }
+                    { // j3 -> i3
+                        if (pop_dec != pop_inc) {
+                            const double lambda_sm = ss * nn.at(pop_inc, 2) * uu.at(2) * nn.at(pop_dec, 3) / (double) NN;
+                            const double lambda_s = 0.5 * ss * nn.at(pop_inc, 3) * (1.0 - 2.0 * uu.at(3)) * nn.at(pop_dec, 3) / (double) NN;
+                            ww.at(pop_dec, 3, pop_inc, 3) = lambda_sm + lambda_s;
                         }
+                    }
 
-                        { // j1 -> i2
-                            const double lambda_sm = ss * nn(pop_inc, 1) * _uu.at(1) * nn(pop_dec, 1) / (double) _NN;
-                            double lambda_am = 0.0;
-                            if (pop_dec == pop_inc)
-                                lambda_am = (1.0 - ss) * nn(pop_inc, 1) * _uu.at(1);
-                            const double lambda_s = 0.5 * ss * nn(pop_inc, 2) * (1.0 - 2.0 * _uu.at(2)) * nn(pop_dec, 1) / (double) _NN;
-                            ww.at(pop_dec, 1, pop_inc, 2) = lambda_sm + lambda_am + lambda_s;
-                        }
+                    { // j3 -> i4
+                        const double lambda_sm = ss * nn.at(pop_inc, 3) * uu.at(3) * nn.at(pop_dec, 3) / (double) NN;
+                        double lambda_am = 0.0;
+                        if (pop_dec == pop_inc)
+                            lambda_am = (1.0 - ss) * nn.at(pop_inc, 3) * uu.at(3);
+                        ww.at(pop_dec, 3, pop_inc, 4) = lambda_sm + lambda_am;
+                    }
+                }
 
-                        { // j1 -> i3
-                            const double lambda_sm = ss * nn(pop_inc, 2) * _uu.at(2) * nn(pop_dec, 1) / (double) _NN;
-                            const double lambda_s = 0.5 * ss * nn(pop_inc, 3) * (1.0 - 2.0 * _uu.at(3)) * nn(pop_dec, 1) / (double) _NN;
-                            ww.at(pop_dec, 1, pop_inc, 3) = lambda_sm + lambda_s;
-                        }
 
-                        { // j1 -> i4
-                            ww.at(pop_dec, 1, pop_inc, 4) = ss * nn(pop_inc, 3) * _uu.at(3) * nn(pop_dec, 1) / (double) _NN;
-                        }
+            return ww;
 
-                        { // j2 -> i0
-                            ww.at(pop_dec, 2, pop_inc, 0) = 0.5 * ss * nn(pop_inc, 0) * (1.0 - 2.0 * _uu.at(0)) * nn(pop_dec, 2) / (double) _NN;
-                        }
+        }
 
-                        { // j2 -> i1
-                            const double lambda_sm = ss * nn(pop_inc, 0) * _uu.at(0) * nn(pop_dec, 2) / (double) _NN;
-                            const double lambda_s = 0.5 * ss * nn(pop_inc, 1) * (1.0 - 2.0 * _uu.at(1)) * nn(pop_dec, 2) / (double) _NN;
-                            ww.at(pop_dec, 2, pop_inc, 1) = lambda_sm + lambda_s;
-                        }
+        /**
+         * accumulation of four mutations (5 stages) in a Moran process \n
+         * requires four mutation rates\n
+         * can be used to study accumulation of fewer mutations by stopping process once the appropriate stem cell has arisen\n
+         */
+        template <class population_type>
+        class Moran5 : public Configuration<time_type, population_type> {
+        public:
 
-                        { // j2 -> i2
-                            if (pop_dec != pop_inc) {
-                                const double lambda_sm = ss * nn(pop_inc, 1) * _uu.at(1) * nn(pop_dec, 2) / (double) _NN;
-                                const double lambda_s = 0.5 * ss * nn(pop_inc, 2) * (1.0 - 2.0 * _uu.at(2)) * nn(pop_dec, 2) / (double) _NN;
-                                ww.at(pop_dec, 2, pop_inc, 2) = lambda_sm + lambda_s;
-                            }
-                        }
+            typedef configuration_categories::moran_category category;
 
-                        { // j2 -> i3
-                            const double lambda_sm = ss * nn(pop_inc, 2) * _uu.at(2) * nn(pop_dec, 2) / (double) _NN;
-                            double lambda_am = 0.0;
-                            if (pop_dec == pop_inc)
-                                lambda_am = (1.0 - ss) * nn(pop_inc, 2) * _uu.at(2);
-                            const double lambda_s = 0.5 * ss * nn(pop_inc, 3) * (1.0 - 2.0 * _uu.at(3)) * nn(pop_dec, 2) / (double) _NN;
-                            ww.at(pop_dec, 2, pop_inc, 3) = lambda_sm + lambda_am + lambda_s;
-                        }
+        private:
 
-                        { // j2 -> i4
-                            ww.at(pop_dec, 2, pop_inc, 4) = ss * nn(pop_inc, 3) * _uu.at(3) * nn(pop_dec, 2) / (double) _NN;
-                        }
+            typedef Configuration<time_type, population_type> base_type;
 
-                        { // j3 -> i0
-                            ww.at(pop_dec, 3, pop_inc, 0) = 0.5 * ss * nn(pop_inc, 0) * (1.0 - 2.0 * _uu.at(0)) * nn(pop_dec, 3) / (double) _NN;
-                        }
+        private:
 
-                        { // j3 -> i1
-                            const double lambda_sm = ss * nn(pop_inc, 0) * _uu.at(0) * nn(pop_dec, 3) / (double) _NN;
-                            const double lambda_s = 0.5 * ss * nn(pop_inc, 1) * (1.0 - 2.0 * _uu.at(1)) * nn(pop_dec, 3) / (double) _NN;
-                            ww.at(pop_dec, 3, pop_inc, 1) = lambda_sm + lambda_s;
-                        }
+            /* probabilities required to implement update_populations_and_time(...) method */
+            const MutationRates _uu;
+            const Symmetry _ss;
 
-                        { // j3 -> i2
-                            const double lambda_s = 0.5 * ss * nn(pop_inc, 2) * (1.0 - 2.0 * _uu.at(2)) * nn(pop_dec, 3) / (double) _NN;
-                            const double lambda_sm = ss * nn(pop_inc, 1) * _uu.at(1) * nn(pop_dec, 3) / (double) _NN;
-                            ww.at(pop_dec, 3, pop_inc, 2) = lambda_sm + lambda_s;
-                        }
+            /* mutation rates with which the process is simulated (importance sampling) */
+            const MutationRates _uu_sampling;
+            const bool _tilted;
 
-                        { // j3 -> i3
-                            if (pop_dec != pop_inc) {
-                                const double lambda_sm = ss * nn(pop_inc, 2) * _uu.at(2) * nn(pop_dec, 3) / (double) _NN;
-                                const double lambda_s = 0.5 * ss * nn(pop_inc, 3) * (1.0 - 2.0 * _uu.at(3)) * nn(pop_dec, 3) / (double) _NN;
-                                ww.at(pop_dec, 3, pop_inc, 3) = lambda_sm + lambda_s;
-                            }
-                        }
+            const long long int _NN; // total population size (constant in time)
 
-                        { // j3 -> i4
-                            const double lambda_sm = ss * nn(pop_inc, 3) * _uu.at(3) * nn(pop_dec, 3) / (double) _NN;
-                            double lambda_am = 0.0;
-                            if (pop_dec == pop_inc)
-                                lambda_am = (1.0 - ss) * nn(pop_inc, 3) * _uu.at(3);
-                            ww.at(pop_dec, 3, pop_inc, 4) = lambda_sm + lambda_am;
-                        }
-                    }
+        private:
 
+            /**
+             * fetch current population size of stage-spe cells in sub-population pop
+             */
+            const population_type nn(const int &pop, const int &spe) const {
 
-                return ww;
+                return this->get_population(Pop(pop), Spe(spe));
+            }
+
+            /**
+             * calculate "marginal" transition rates given the current state, mutation rates uu and symmetry ss
+             */
+            const array::Array4D<double> compute_transition_rates(const MutationRates &uu, const double &ss) const {
 
+                return transition_rates(this->get_population2D(), uu, ss, _NN);
             }
 
             /**
@@ -234,14 +251,17 @@ namespace monte_carlo {
             void update_populations_gillespie(
                     base_generator_type &base_rand_gen,
                     const array::Array4D<double> &ww,
-                    const double &ww_total) {
+                    const double &ww_total,
+                    int &pop_dec,
+                    int &spe_dec,
+                    int &pop_inc,
+                    int &spe_inc) {
 
                 /* randomly choose next reaction using inverse CDF method */
                 typedef boost::random::uniform_real_distribution<> uniform_generator_type;
                 typedef boost::random::variate_generator<base_generator_type&, uniform_generator_type> uniform_variate_type;
                 uniform_variate_type uniform_random_number(base_rand_gen, uniform_generator_type(0.0, 1.0));
                 const double random_fraction_ww_total = uniform_random_number() * ww_total;
-                int pop_dec, spe_dec, pop_inc, spe_inc;
                 if (!ww.cumulative_sum(random_fraction_ww_total, pop_dec, spe_dec, pop_inc, spe_inc)) {
                     std::cerr << "could not choose next reaction" << std::endl;
                     std::cerr << "random_fraction_ww_total = " << random_fraction_ww_total << std::endl;
@@ -259,18 +279,46 @@ namespace monte_carlo {
             }
 
             /**
-             * update time
+             * update time \n
+             * returns time to next event
              */
-            void update_time_gillespie(base_generator_type &base_rand_gen, const double &ww_total) {
+            const time_type update_time_gillespie(base_generator_type &base_rand_gen, const double &ww_total) {
 
                 /* update time using an exponentially distributed inter-event time */
                 typedef boost::random::exponential_distribution<> exponential_generator_type;
                 typedef boost::random::variate_generator<base_generator_type&, exponential_generator_type> exponential_variate_type;
                 exponential_variate_type exponential_random_number(base_rand_gen, exponential_generator_type(ww_total));
 
+                const time_type waiting_time = static_cast<time_type> (exponential_random_number());
+
                 // this-> makes argument to set_time template-parameter-dependent 
-                set_time(this->get_time() + static_cast<time_type> (exponential_random_number()));
+                set_time(this->get_time() + waiting_time);
+
+                return waiting_time;
+
+            }
+
+            /**
+             * nominal transition rates after a unit increase of each mutation rate, followed by symmetry \n
+             * every rate is affine in each mutation rate and in symmetry, \n
+             * so the change in rates caused by a unit increase of a parameter is the exact derivative of the rates
+             */
+            const std::vector<array::Array4D<double> > compute_shifted_transition_rates() const {
+
+                std::vector<array::Array4D<double> > ww_shifted;
+                for (int parameter = 0; parameter <= _uu.size(); parameter++) {
+
+                    MutationRates uu_shifted(_uu);
+                    double ss_shifted = _ss.value();
+                    if (parameter < _uu.size())
+                        uu_shifted.at(parameter) += 1.0;
+                    else
+                        ss_shifted += 1.0;
 
+                    ww_shifted.push_back(compute_transition_rates(uu_shifted, ss_shifted));
+                }
+
+                return ww_shifted;
             }
 
             /**
@@ -281,7 +329,7 @@ namespace monte_carlo {
                 /* calculate "marginal" transition rates
                  * ie rates at which system changes state 
                  */
-                const array::Array4D<double> ww = compute_transition_rates();
+                const array::Array4D<double> ww = compute_transition_rates(_uu_sampling, _ss.value());
 
 #ifdef DEBUG_MORAN5
                 /* inspect ww array */
@@ -292,28 +340,70 @@ namespace monte_carlo {
                 /* calculate rate at which next event occurs */
                 const double ww_total = ww.sum();
 
+                /* nominal rates, and their changes under unit parameter shifts, are needed to weight tilted paths and to accumulate the score, \n
+                 * and must be calculated before the state changes */
+                array::Array4D<double> ww_nominal;
+                if (_tilted || this->score_tracked()) ww_nominal = _tilted ? compute_transition_rates(_uu, _ss.value()) : ww;
+                std::vector<array::Array4D<double> > ww_shifted;
+                if (this->score_tracked()) ww_shifted = compute_shifted_transition_rates();
+
                 /* update populations */
-                update_populations_gillespie(base_rand_gen, ww, ww_total);
+                int pop_dec, spe_dec, pop_inc, spe_inc;
+                update_populations_gillespie(base_rand_gen, ww, ww_total, pop_dec, spe_dec, pop_inc, spe_inc);
 
                 /* update time */
-                update_time_gillespie(base_rand_gen, ww_total);
+                const time_type waiting_time = update_time_gillespie(base_rand_gen, ww_total);
+
+                /* likelihood ratio of the event and of the waiting time before it: \n
+                 * (w_nominal / w_sampling) * exp(-(W_nominal - W_sampling) * waiting_time) */
+                if (_tilted)
+                    this->add_log_likelihood_ratio(
+                        std::log(ww_nominal.at(pop_dec, spe_dec, pop_inc, spe_inc) / ww.at(pop_dec, spe_dec, pop_inc, spe_inc))
+                        - (ww_nominal.sum() - ww_total) * waiting_time);
+
+                /* derivative of log probability of the event and of the waiting time before it: \n
+                 * dw_nominal / w_nominal - dW_nominal * waiting_time; \n
+                 * an event that is impossible under nominal parameters gives a path of zero likelihood ratio, and is skipped */
+                const double ww_event = this->score_tracked() ? ww_nominal.at(pop_dec, spe_dec, pop_inc, spe_inc) : 0.0;
+                if (ww_event > 0.0) {
+                    const double ww_nominal_total = ww_nominal.sum();
+                    for (int parameter = 0; parameter < ww_shifted.size(); parameter++)
+                        this->add_score(parameter,
+                            (ww_shifted.at(parameter).at(pop_dec, spe_dec, pop_inc, spe_inc) - ww_event) / ww_event
+                            - (ww_shifted.at(parameter).sum() - ww_nominal_total) * waiting_time);
+                }
 
             }
 
         public:
 
             /**
-             * constructor
+             * accumulate derivatives of log probability of path with respect to the four mutation rates and symmetry
+             */
+            virtual void track_score() {
+
+                this->start_score(_uu.size() + 1);
+            }
+
+            /**
+             * constructor \n
+             * if uu_sampling is given, the process is simulated with mutation rates uu_sampling instead of uu \n
+             * and each path is weighted by its likelihood ratio (importance sampling); \n
+             * uu_sampling must be positive wherever uu is
              */
             explicit Moran5(
                     const Population2D<population_type> &population2D,
                     const MutationRates &uu,
                     const Symmetry &ss,
-                    const Uniform_Time_Grid<time_type> &time_grid)
-            : base_type(population2D, time_grid), _uu(uu), _ss(ss), _NN(population2D.sum()) {
+                    const Uniform_Time_Grid<time_type> &time_grid,
+                    const MutationRates &uu_sampling = MutationRates())
+            : base_type(population2D, time_grid), _uu(uu), _ss(ss),
+            _uu_sampling(uu_sampling.size() == 0 ? uu : uu_sampling), _tilted(uu_sampling.size() != 0),
+            _NN(population2D.sum()) {
 
                 assert(population2D.number_species() == 5);
                 assert(uu.size() == 4);
+                assert(valid_sampling_rates(_uu, _uu_sampling));
             }
 
         };
@@ -0,0 +1,105 @@
+#ifndef MUTATION_GRAPH_H
+#define	MUTATION_GRAPH_H
+
+#include <boost/static_assert.hpp> // BOOST_STATIC_ASSERT
+#include <boost/mpl/vector.hpp> // boost::mpl::vector
+#include <boost/mpl/range_c.hpp> // boost::mpl::range_c
+#include <boost/mpl/transform.hpp> // boost::mpl::transform
+#include <boost/mpl/back_inserter.hpp> // boost::mpl::back_inserter
+#include <boost/mpl/placeholders.hpp> // boost::mpl::_1
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * mutation graphs: species are the nodes, and each edge is a mutation, at a given rate, from one species to another \n
+     * a graph is a class with \n
+     * enum { number_species = .., number_rates = .. } \n
+     * typedef boost::mpl::vector<Mutation_Edge<..>, ..> edges; \n
+     * the order of edges leaving a species fixes the order of its reaction categories (see Branching_Discrete_Graph) \n
+     * species are numbered so that mutations only lead to species of higher number, so graphs are acyclic, \n
+     * and the species of highest number has no mutations (it is the last species of the statistics gatherers)
+     */
+    namespace mutation_graph {
+
+        /**
+         * mutation of a type-Source cell to a type-Target cell at the mutation rate of index Rate \n
+         * enum hack (Item 2)
+         */
+        template <int Source, int Target, int Rate>
+        struct Mutation_Edge {
+
+            BOOST_STATIC_ASSERT(Source >= 0 && Source < Target);
+            BOOST_STATIC_ASSERT(Rate >= 0);
+
+            enum {
+                source = Source,
+                target = Target,
+                rate = Rate
+            };
+        };
+
+        namespace mutation_graph_detail {
+
+            /**
+             * edge from species Index to species Index + 1, at mutation rate Index
+             */
+            template <class Index>
+            struct chain_edge {
+
+                typedef Mutation_Edge<Index::value, Index::value + 1, Index::value> type;
+            };
+
+        }
+
+        /**
+         * number_species species in a line: species spe mutates to species spe + 1 at mutation rate spe \n
+         * the model of Branching_Discrete
+         */
+        template <int number_species_>
+        struct Linear_Chain {
+
+            BOOST_STATIC_ASSERT(number_species_ >= 2);
+
+            enum {
+                number_species = number_species_,
+                number_rates = number_species_ - 1
+            };
+
+            typedef typename boost::mpl::transform<
+            boost::mpl::range_c<int, 0, number_species_ - 1>,
+            mutation_graph_detail::chain_edge<boost::mpl::_1>,
+            boost::mpl::back_inserter<boost::mpl::vector0<> >
+            >::type edges;
+        };
+
+        /**
+         * two pathways to a double mutant: AB -> aB -> ab and AB -> Ab -> ab \n
+         * species AB aB Ab ab; mutation rates u_0a u_0b u_a u_b \n
+         * the model of Branching_Discrete_Diamond
+         */
+        struct Diamond_Graph {
+
+            enum {
+                number_species = 4,
+                number_rates = 4
+            };
+
+            typedef boost::mpl::vector<
+            Mutation_Edge<0, 1, 0>,
+            Mutation_Edge<0, 2, 1>,
+            Mutation_Edge<1, 3, 2>,
+            Mutation_Edge<2, 3, 3>
+            > edges;
+        };
+
+    }
+
+    using mutation_graph::Mutation_Edge;
+    using mutation_graph::Linear_Chain;
+    using mutation_graph::Diamond_Graph;
+
+}
+
+#endif	/* MUTATION_GRAPH_H */
@@ -61,6 +61,24 @@ namespace monte_carlo {
 
     using MutationRates_namespace::MutationRates;
 
+    /**
+     * returns true if mutation rates uu_sampling may be used to simulate a process with mutation rates uu (importance sampling): \n
+     * sizes agree, rates are probabilities below one half, and uu_sampling is positive wherever uu is, \n
+     * so that every path possible under uu is possible under uu_sampling \n
+     * non-member function (Item 23)
+     */
+    inline const bool valid_sampling_rates(const MutationRates &uu, const MutationRates &uu_sampling) {
+
+        if (uu.size() != uu_sampling.size()) return false;
+
+        for (int ii = 0; ii < uu.size(); ii++) {
+            if ((uu_sampling.at(ii) < 0.0) || (uu_sampling.at(ii) >= 0.5)) return false;
+            if ((uu.at(ii) > 0.0) && (uu_sampling.at(ii) <= 0.0)) return false;
+        }
+
+        return true;
+    }
+
 
 
 }
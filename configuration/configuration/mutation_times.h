@@ -29,6 +29,9 @@ namespace monte_carlo {
         // boolean variables indicating whether corresponding mutations have occurred or not 
         array::Array2D<bool> _mutations_occurred;
 
+        /* number of mutation times recorded so far */
+        int _number_recorded;
+
 
     private:
 
@@ -44,6 +47,7 @@ namespace monte_carlo {
                         {
                             _mutation_times.at(pop, spe) = tt; // record the mutation time
                             _mutations_occurred.at(pop, spe) = true; // indicate that mutation has occurred
+                            _number_recorded++;
                         }
         }
 
@@ -52,7 +56,7 @@ namespace monte_carlo {
         /**
          * custom constructor
          */
-        explicit MutationTimes(const population2D_type & population2D) {
+        explicit MutationTimes(const population2D_type & population2D) : _number_recorded(0) {
 
             _mutation_times = array::Array2D<time_type > (population2D.number_sub_pops(), population2D.number_species(), static_cast<time_type> (-1));
             _mutations_occurred = array::Array2D<bool > (population2D.number_sub_pops(), population2D.number_species(), false);
@@ -78,6 +82,14 @@ namespace monte_carlo {
             return _mutation_times.at(pop.value(), spe.value());
         }
 
+        /**
+         * number of mutation times recorded so far
+         */
+        const int number_recorded() const {
+
+            return _number_recorded;
+        }
+
 
     };
 
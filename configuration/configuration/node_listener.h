@@ -0,0 +1,52 @@
+#ifndef NODE_LISTENER_H
+#define	NODE_LISTENER_H
+
+#include <mutation_accumulation/parameters/parameters_fwd.h> // monte_carlo::Node
+
+#include "population2D.h" // monte_carlo::Population2D
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * abstract base class of objects that are told, during transition(), each time a trajectory crosses a node of the time grid\n
+     * a path with an attached listener streams its node values to the listener instead of storing them, \n
+     * so memory per trajectory does not grow with the number of nodes \n
+     * may use this class polymorphically (virtual destructor) \n
+     * may not instantiate (ctor is protected)\n
+     */
+    template <class population_type>
+    class Node_Listener {
+    protected:
+
+        /**
+         * this is an empty constructor\n
+         */
+        explicit Node_Listener() {
+
+        }
+
+    public:
+
+        /**
+         * virtual destructor\n
+         * ensures that objects can be deleted properly using interface base class pointers\n
+         * this function is public so that one can call delete through a base-class pointer
+         */
+        virtual ~Node_Listener() {
+
+        }
+
+        /**
+         * trajectory has reached node; node_value holds the populations at the time of the node \n
+         * node_value may hold more species than the configuration reports (e.g. Moran3 delegates to Moran4), \n
+         * so listeners should loop over the species they track
+         */
+        virtual void node_crossed(const Node &node, const Population2D<population_type> &node_value) = 0;
+
+    };
+
+}
+
+#endif	/* NODE_LISTENER_H */
@@ -3,13 +3,15 @@
 
 #include "population2D.h" // monte_carlo::Population2D
 #include "time_grid.h" // Uniform_Time_Grid
+#include "node_listener.h" // monte_carlo::Node_Listener
 
 /*************************************************************************/
 
 namespace monte_carlo {
 
     /**
-     * store configurations at a grid of time points 
+     * store configurations at a grid of time points \n
+     * if a Node_Listener is attached, configurations are streamed to the listener as nodes are crossed, rather than stored
      */
     template <class time_type, class population_type>
     class Path {
@@ -18,6 +20,23 @@ namespace monte_carlo {
         typedef Population2D<population_type> population2D_type;
         std::vector<population2D_type> _node_values;
         Uniform_Time_Grid<time_type> _node_times; // must contain at least the initial time point and the final time point
+        int _number_filled_nodes;
+        Node_Listener<population_type> *_listener; // not owned; null unless streaming
+
+    private:
+
+        /**
+         * record value at next node
+         */
+        void fill_next_node(const population2D_type &value) {
+
+            if (_listener)
+                _listener->node_crossed(Node(_number_filled_nodes), value);
+            else
+                _node_values.push_back(value);
+
+            _number_filled_nodes++;
+        }
 
     public:
 
@@ -29,8 +48,33 @@ namespace monte_carlo {
                 const Uniform_Time_Grid<time_type> &node_times)
         :
         _node_values(std::vector<population2D_type>(1, initial_node_value)),
-        _node_times(node_times) {
+        _node_times(node_times),
+        _number_filled_nodes(1),
+        _listener(0) {
+
+        }
+
+        /**
+         * stream node values to listener from now on, starting with the initial node \n
+         * must be called before the trajectory starts
+         */
+        void attach_listener(Node_Listener<population_type> * const listener) {
+
+            assert(_number_filled_nodes == 1 && _node_values.size() == 1);
+
+            _listener = listener;
+            _listener->node_crossed(Node(0), _node_values.front());
+            _node_values.clear();
+        }
+
+        /**
+         * record value at every node not yet reached \n
+         * valid only if the value can no longer change (e.g. the population has gone extinct)
+         */
+        void fill_remaining_nodes(const population2D_type &value) {
 
+            while (!complete())
+                fill_next_node(value);
         }
 
         /**
@@ -38,7 +82,7 @@ namespace monte_carlo {
          */
         const bool complete() const {
 
-            const int number_filled_nodes = _node_values.size();
+            const int number_filled_nodes = _number_filled_nodes;
             const int total_number_nodes = _node_times.size();
 
             if (number_filled_nodes < total_number_nodes) {
@@ -58,10 +102,10 @@ namespace monte_carlo {
          */
         void update(const int &tt, const population2D_type &value) {
 
-            const Node next_node(_node_values.size());
+            const Node next_node(_number_filled_nodes);
 
             if (tt >= _node_times.at(next_node))
-                _node_values.push_back(value);
+                fill_next_node(value);
 
         }
 
@@ -72,19 +116,25 @@ namespace monte_carlo {
         void update(const double &tt, const population2D_type &value, const population2D_type &value_old) {
 
             while (!complete()) {
-                const Node next_node(_node_values.size());
+                const Node next_node(_number_filled_nodes);
                 if (tt > _node_times.at(next_node))
-                    _node_values.push_back(value_old);
+                    fill_next_node(value_old);
                 else
                     return;
             }
         }
 
         /**
-         * get population of species spe in sub-population pop at time indicated by node
+         * get population of species spe in sub-population pop at time indicated by node \n
+         * not available if node values were streamed to a listener
          */
         const population_type at(const Pop &pop, const Spe &spe, const Node &node) const {
 
+            if (_listener) {
+                std::cerr << "node values were streamed to a listener, not stored" << std::endl;
+                assert(false);
+            }
+
             population2D_type node_value;
             try {
                 node_value = _node_values.at(node.value());
@@ -108,7 +158,7 @@ namespace monte_carlo {
          */
         const int number_filled_nodes() const {
 
-            return _node_values.size();
+            return _number_filled_nodes;
         }
 
         /**
@@ -1,9 +1,7 @@
 #ifndef PATH_POLICY_H
 #define	PATH_POLICY_H
 
-#include <mutation_accumulation/configuration/utilities/fpt_mutation_lastSpecies.h> // monte_carlo::all_last_species_occurred
-#include <mutation_accumulation/configuration/utilities/fpt_extinction.h> // monte_carlo::extinguished
-#include <mutation_accumulation/configuration/utilities/fate.h> // monte_carlo::eventualFateOccurred_lastSpecies_allSubPops
+#include <mutation_accumulation/configuration/utilities/trial_summary.h> // monte_carlo::Trial_Summary
 
 #include <mutation_accumulation/configuration/configuration/random_fwd.h> // monte_carlo::base_generator_type
 
@@ -16,6 +14,9 @@ namespace monte_carlo {
      * \n
      * Template Method Pattern via the Non-Virtual Interface Idiom (Item 35)\n
      * \n
+     * paths are evaluated from the Trial_Summary that is updated after each transition, \n
+     * rather than by re-querying the configuration\n
+     * \n
      * may use this class polymorphically (virtual destructor) \n
      * may not instantiate (ctor is protected)\n
      */
@@ -24,6 +25,7 @@ namespace monte_carlo {
     public:
 
         typedef Configuration_type Configuration_t;
+        typedef Trial_Summary<Configuration_type> Summary_t;
 
     private:
 
@@ -34,12 +36,24 @@ namespace monte_carlo {
         
         std::vector<base_generator_type> _successful_PRNG_states;
 
+        /* whether decided sub-populations were frozen in the recorded trajectories (see freeze_decided) */
+        bool _successful_freeze_decided;
+
     private:
 
         /** 
          * return true if path is successful
          */
-        virtual const bool success(const Configuration_type &configuration) const = 0;
+        virtual const bool success(const Summary_t &summary) const = 0;
+
+        /**
+         * return true if the future of sub-population pop cannot change the evaluation of the path \n
+         * by default, only extinct sub-populations, which never change again, are decided
+         */
+        virtual const bool decided(const Summary_t &summary, const Pop &pop) const {
+
+            return summary.extinguished(pop);
+        }
 
 
     protected:
@@ -48,7 +62,7 @@ namespace monte_carlo {
          * protected ctor prevents instantiation of base class 
          * 
          */
-        explicit Path_Policy_Base() : _successful_PRNG_states(std::vector<base_generator_type>()) {
+        explicit Path_Policy_Base() : _successful_PRNG_states(std::vector<base_generator_type>()), _successful_freeze_decided(false) {
 
             /* check template parameter types to supplement "duck typing" */
             BOOST_STATIC_ASSERT((boost::is_base_of<Configuration_Interface<time_type, population_type>, Configuration_type>::value));
@@ -70,27 +84,42 @@ namespace monte_carlo {
         }
 
         /** 
-         * record initial state of PRNG if path is successful
+         * record initial state of PRNG if path is successful \n
+         * freeze_decided indicates whether the path froze decided sub-populations, so that it can be replayed exactly
          */
-        void record_success(const Configuration_type &configuration, const base_generator_type &PRNG_state) {
+        void record_success(const Summary_t &summary, const base_generator_type &PRNG_state, const bool &freeze_decided) {
+
+            _successful_freeze_decided = freeze_decided;
 
             if (_successful_PRNG_states.size() < 10) 
-                if (success(configuration))
+                if (success(summary))
                     _successful_PRNG_states.push_back(PRNG_state);
         }
 
         /** 
          * return true if path should be terminated
          */
-        const bool terminate(const Configuration_type &configuration) const {
+        const bool terminate(const Summary_t &summary) const {
 
-            const bool cond1 = configuration.end();
-            const bool cond2 = success(configuration);
-            const bool cond3 = extinguished(configuration);  // 8th March 2013
+            const bool cond1 = summary.end();
+            const bool cond2 = success(summary);
+            const bool cond3 = summary.extinguished();  // 8th March 2013
             
             return (cond1 || cond2 || cond3);
         }
 
+        /**
+         * ask configuration to stop updating sub-populations that are decided \n
+         * first-passage data of a decided sub-population is fixed, so only statistics of its later state \n
+         * (path populations, extinction times) are affected; call only if statistics do not need them \n
+         * (see Statistics_Gatherer::needs_decided_sub_pops)
+         */
+        void freeze_decided(const Summary_t &summary, Configuration_type &configuration) const {
+
+            for (int pop = 0; pop < summary.number_sub_pops(); pop++)
+                if (decided(summary, Pop(pop))) configuration.freeze(Pop(pop));
+        }
+
         /**
          * get collection of initial PRNG states that yield successful trajectories 
          */
@@ -98,6 +127,14 @@ namespace monte_carlo {
             
             return _successful_PRNG_states;
         }
+
+        /**
+         * query whether the trajectories of successful_PRNG_states() froze decided sub-populations
+         */
+        const bool successful_freeze_decided() const {
+
+            return _successful_freeze_decided;
+        }
         
     };
 
@@ -111,9 +148,9 @@ namespace monte_carlo {
         /** 
          * return true if path is successful
          */
-        virtual const bool success(const Configuration_type &configuration) const {
+        virtual const bool success(const Trial_Summary<Configuration_type> &summary) const {
 
-            return extinguished(configuration);
+            return summary.extinguished();
             
         }
 
@@ -131,12 +168,20 @@ namespace monte_carlo {
         /** 
          * return true if path is successful
          */
-        virtual const bool success(const Configuration_type &configuration) const {
+        virtual const bool success(const Trial_Summary<Configuration_type> &summary) const {
 
-            return all_last_species_occurred__within_timeSpan(configuration); // new
+            return summary.all_last_species_occurred__within_timeSpan(); // new
             
         }
 
+        /**
+         * sub-population is decided once every species has arisen in it, or it has extinguished
+         */
+        virtual const bool decided(const Trial_Summary<Configuration_type> &summary, const Pop &pop) const {
+
+            return (summary.all_mutations_occurred(pop) || summary.extinguished(pop));
+        }
+
 
     };
 
@@ -151,9 +196,37 @@ namespace monte_carlo {
         /** 
          * return true if path is successful
          */
-        virtual const bool success(const Configuration_type &configuration) const {
+        virtual const bool success(const Trial_Summary<Configuration_type> &summary) const {
+
+            return summary.eventualFateOccurred_lastSpecies_allSubPops();
+            
+        }
+
+        /**
+         * sub-population is decided once every species has arisen in it, or it has extinguished
+         */
+        virtual const bool decided(const Trial_Summary<Configuration_type> &summary, const Pop &pop) const {
+
+            return (summary.all_mutations_occurred(pop) || summary.extinguished(pop));
+        }
+
+
+    };
+
+    /** 
+     * terminate path when penultimate species has arisen or sub-pop has extinguished for all sub-pops \n
+     * the last mutation step is then integrated out (see Statistics_Lifetime_Risk_Conditional)
+     */
+    template<class Configuration_type>
+    class Wait_For_Penultimate_Species_In_All_SubPops : public Path_Policy_Base<Configuration_type> {
+    private:
+
+        /** 
+         * return true if path is successful
+         */
+        virtual const bool success(const Trial_Summary<Configuration_type> &summary) const {
 
-            return eventualFateOccurred_lastSpecies_allSubPops(configuration);
+            return summary.eventualFateOccurred_penultimateSpecies_allSubPops();
             
         }
 
@@ -170,7 +243,7 @@ namespace monte_carlo {
         /** 
          * return true if path is successful
          */
-        virtual const bool success(const Configuration_type &configuration) const {
+        virtual const bool success(const Trial_Summary<Configuration_type> &summary) const {
 
             return false;
             
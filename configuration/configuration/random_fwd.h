@@ -1,21 +1,42 @@
 #ifndef RANDOM_FWD_H
 #define	RANDOM_FWD_H
 
-#include <boost/random/mersenne_twister.hpp> // boost::random::mt19937
+/**
+ * engine that drives every simulation, selected at compile time by defining one of \n
+ * RNG_XOSHIRO256PP: xoshiro256++ (32 bytes of state; see mutation_accumulation::random::xoshiro256pp) \n
+ * RNG_PCG64: PCG64 (32 bytes of state; see mutation_accumulation::random::pcg64) \n
+ * RNG_MT19937_64: 64-bit Mersenne twister (2.5 KB of state) \n
+ * otherwise the 32-bit Mersenne twister (2.5 KB of state), whose streams earlier results were computed with \n
+ * engines differ in their streams, so results obtained with one engine are not reproduced by another
+ */
+#if defined(RNG_XOSHIRO256PP)
+#include <mutation_accumulation/random/xoshiro256pp.h> // mutation_accumulation::random::xoshiro256pp
+#elif defined(RNG_PCG64)
+#include <mutation_accumulation/random/pcg64.h> // mutation_accumulation::random::pcg64
+#else
+#include <boost/random/mersenne_twister.hpp> // boost::random::mt19937, boost::random::mt19937_64
+#endif
 
 /*************************************************************************/
 
 namespace monte_carlo {
 
-    typedef boost::random::mt19937 base_generator_type; 
+#if defined(RNG_XOSHIRO256PP)
+    typedef mutation_accumulation::random::xoshiro256pp base_generator_type;
+#elif defined(RNG_PCG64)
+    typedef mutation_accumulation::random::pcg64 base_generator_type;
+#elif defined(RNG_MT19937_64)
+    typedef boost::random::mt19937_64 base_generator_type;
+#else
+    typedef boost::random::mt19937 base_generator_type;
+#endif
 
 }
 
 namespace patterns {
 
-    typedef boost::random::mt19937 base_generator_type; 
+    typedef monte_carlo::base_generator_type base_generator_type;
 
 }
 
 #endif	/* RANDOM_FWD_H */
-
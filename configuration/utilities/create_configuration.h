@@ -1,8 +1,12 @@
 #ifndef CREATE_CONFIGURATION_H
 #define	CREATE_CONFIGURATION_H
 
+#include <iostream> // std::cerr
+#include <cassert> // assert
+
 #include <mutation_accumulation/utility/configuration_traits.h> // configuration_types::branching_type etc
 #include <mutation_accumulation/simulation/read_policy.h> // Read_Homeostasis_Policy<Configuration_type>
+#include <mutation_accumulation/configuration/configuration/branching_discrete.h> // monte_carlo::Branching_Discrete
 
 /*************************************************************************/
 
@@ -24,21 +28,86 @@ namespace monte_carlo {
 
     }
 
+    namespace create_configuration_detail {
+
+        /**
+         * generic configurations update their sub-populations in turn, from a single random stream
+         */
+        template <class Configuration_type>
+        void update_sub_pops_in_parallel(Configuration_type &configuration, const int &number_threads) {
+
+            if (number_threads != 0) {
+                std::cerr << "configuration cannot update sub-populations in parallel" << std::endl;
+                assert(false);
+            }
+        }
+
+        /**
+         * Branching_Discrete can (see Branching_Discrete::update_sub_pops_in_parallel) \n
+         * overload is preferred to the generic template by partial ordering
+         */
+        template <class population_type>
+        void update_sub_pops_in_parallel(Branching_Discrete<population_type> &configuration, const int &number_threads) {
+
+            configuration.update_sub_pops_in_parallel(number_threads);
+        }
+
+    }
+
     /** 
-     * create instance of a branching configuration, with arbitrary renewal bias
+     * create instance of a branching configuration, with arbitrary renewal bias \n
+     * sub-populations are updated on the number of threads given in the input file (see read_policy_detail::read_trailing_options)
      */
     template <class Configuration_type>
     const Configuration_type create_configuration(
             const configuration_categories::branching_category,
             const Read_Policy_Base<Configuration_type> &read_policy) {
 
-        return Configuration_type(
+        Configuration_type configuration(
                 read_policy.get_population(),
                 read_policy.getUu(), 
                 read_policy.getSymmetry(), 
                 read_policy.get_SymmetricRenewal(), 
                 read_policy.getTime_grid());
 
+        create_configuration_detail::update_sub_pops_in_parallel(configuration, read_policy.get_sub_pop_threads());
+
+        return configuration;
+
+    }
+
+    /** 
+     * create instance of a moran configuration from parameter values (renewal bias must equal 1/2) \n
+     * if uu_sampling is given, the configuration is simulated with these mutation rates (importance sampling)
+     */
+    template <class Configuration_type>
+    const Configuration_type create_configuration(
+            const configuration_categories::moran_category,
+            const Population2D<typename Configuration_type::population_t> &NN,
+            const MutationRates &uu,
+            const Symmetry &symmetry,
+            const Uniform_Time_Grid<typename Configuration_type::time_t> &time_grid,
+            const MutationRates &uu_sampling = MutationRates()) {
+
+        return Configuration_type(NN, uu, symmetry, time_grid, uu_sampling);
+
+    }
+
+    /** 
+     * create instance of a homeostatic branching configuration (renewal bias equals 1/2) from parameter values \n
+     * if uu_sampling is given, the configuration is simulated with these mutation rates (importance sampling)
+     */
+    template <class Configuration_type>
+    const Configuration_type create_configuration(
+            const configuration_categories::branching_category,
+            const Population2D<typename Configuration_type::population_t> &NN,
+            const MutationRates &uu,
+            const Symmetry &symmetry,
+            const Uniform_Time_Grid<typename Configuration_type::time_t> &time_grid,
+            const MutationRates &uu_sampling = MutationRates()) {
+
+        return Configuration_type(NN, uu, symmetry, SymmetricRenewal(0.5), time_grid, uu_sampling);
+
     }
 
 }
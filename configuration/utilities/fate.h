@@ -23,7 +23,7 @@ namespace monte_carlo {
 
         if (mutation_occurred(configuration, pop, spe)) {
             return 1;
-        } else if (!mutation_occurred(configuration, pop, spe) && extinguished(configuration, pop)) {
+        } else if (extinguished(configuration, pop)) {
             return 0;
         } else {
             return -1;
@@ -43,7 +43,7 @@ namespace monte_carlo {
 
         if (mutation_occurred(configuration, spe)) {
             return 1;
-        } else if (!mutation_occurred(configuration, spe) && extinguished(configuration)) {
+        } else if (extinguished(configuration)) {
             return 0;
         } else {
             return -1;
@@ -61,11 +61,13 @@ namespace monte_carlo {
     const Pop &pop,
     const Spe &spe) {
 
-        if (fate(configuration, pop, spe) == 1) {
+        const int fate_code = fate(configuration, pop, spe); // evaluate once
+
+        if (fate_code == 1) {
             return true;
-        } else if (fate(configuration, pop, spe) == 0) {
+        } else if (fate_code == 0) {
             return false;
-        } else if (fate(configuration, pop, spe) == -1) {
+        } else if (fate_code == -1) {
             std::cerr << "pop " << pop.value() << " has not acquired spe " << spe.value() << " nor has it extinguished" << std::endl;
             std::cerr << "configuration = " << std::endl;
             std::cerr << configuration << std::endl;
@@ -86,11 +88,13 @@ namespace monte_carlo {
     const configuration_type &configuration,
     const Spe &spe) {
 
-        if (fate(configuration, spe) == 1) {
+        const int fate_code = fate(configuration, spe); // evaluate once
+
+        if (fate_code == 1) {
             return true;
-        } else if (fate(configuration, spe) == 0) {
+        } else if (fate_code == 0) {
             return false;
-        } else if (fate(configuration, spe) == -1) {
+        } else if (fate_code == -1) {
             std::cerr << "entire population has not acquired spe " << spe.value() << " nor has it extinguished" << std::endl;
             std::cerr << "configuration = " << std::endl;
             std::cerr << configuration << std::endl;
@@ -8,7 +8,8 @@
 namespace monte_carlo {
 
     /**
-     * population size specific to pop, spe, and node for a complete path
+     * population size specific to pop, spe, and node for a complete path\n
+     * path must have been stored (see Node_Listener)
      */
     template <class configuration_type>
     const typename configuration_type::population_t calculate_population(
@@ -17,7 +18,7 @@ namespace monte_carlo {
     const Spe &spe,
     const Node &node) {
 
-        return configuration.path().at(pop, spe, node);
+        return configuration.get_path_population(pop, spe, node);
     }
 
     /**
@@ -33,7 +34,7 @@ namespace monte_carlo {
 
         population_type population = static_cast<population_type> (0);
         for (int pop = 0; pop < configuration.number_sub_pops(); pop++)
-            population += configuration.path().at(Pop(pop), spe, node);
+            population += configuration.get_path_population(Pop(pop), spe, node);
 
         return population;
     }
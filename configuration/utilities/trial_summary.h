@@ -0,0 +1,480 @@
+#ifndef TRIAL_SUMMARY_H
+#define	TRIAL_SUMMARY_H
+
+#include <vector> // std::vector
+#include <cassert> // assert
+#include <iostream> // std::cerr
+
+#include <boost/static_assert.hpp> // BOOST_STATIC_ASSERT
+#include <boost/type_traits/is_base_of.hpp> // boost::is_base_of
+
+#include <mutation_accumulation/parameters/parameters_fwd.h> // monte_carlo::Pop, etc
+#include <mutation_accumulation/array/array2D.h> // array::Array2D
+#include <mutation_accumulation/configuration/configuration/configuration_interface.h> // monte_carlo::Configuration_Interface
+#include <mutation_accumulation/configuration/configuration/branching_discrete_diamond.h> // monte_carlo::Branching_Discrete_Diamond
+#include <mutation_accumulation/configuration/utilities/lifetime_risk.h> // monte_carlo::mutation_occurred_within_timeSpan_detail
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace trial_summary_detail {
+
+        /**
+         * generic configurations carry no route information
+         */
+        template <class configuration_type>
+        const bool record_routes(
+        const configuration_type &,
+        const Pop &,
+        bool &,
+        bool &) {
+
+            return false;
+        }
+
+        /**
+         * diamond configurations record which single mutant yielded the first double mutant \n
+         * overload is preferred to the generic template by partial ordering
+         */
+        template <class population_type>
+        const bool record_routes(
+        const Branching_Discrete_Diamond<population_type> &configuration,
+        const Pop &pop,
+        bool &a_yielded_ab,
+        bool &b_yielded_ab) {
+
+            a_yielded_ab = configuration.a_yielded_ab(pop);
+            b_yielded_ab = configuration.b_yielded_ab(pop);
+            return true;
+        }
+
+    }
+
+    /**
+     * compact record of the first-passage data of a single trajectory\n
+     * mutation times and extinction times are fixed once they have been recorded, \n
+     * so update(..) only re-queries the (pop, spe) entries that are still undecided \n
+     * and keeps counters from which success and fate are read in constant time \n
+     * path policies decide termination after every transition, so the summary is updated incrementally \n
+     * rather than built at the end of the trajectory; transitions that record no first passage \n
+     * (see Configuration_Interface::number_first_passages) leave it untouched \n
+     * \n
+     * the summary is shared by path policies (while the trajectory is generated), \n
+     * and by statistics gatherers and raw-data policies (once it has terminated) \n
+     * \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    template <class Configuration_type>
+    class Trial_Summary {
+    public:
+
+        typedef Configuration_type Configuration_t;
+        typedef typename Configuration_type::time_t time_t;
+
+    private:
+
+        typedef typename Configuration_type::time_t time_type; // Item 42
+        typedef typename Configuration_type::population_t population_type;
+        typedef typename data_types::data_traits<time_type>::category time_category_type;
+
+    private:
+
+        int _number_sub_pops;
+        int _number_species;
+        int _number_first_passages;
+        time_type _last_node_time;
+        bool _end;
+
+        array::Array2D<time_type> _mutation_times;
+        std::vector<time_type> _extinction_times;
+
+        /** first time at which spe arose in any sub-population (-1 if it has not arisen) */
+        std::vector<time_type> _mutation_times_whole;
+
+        /** number of sub-populations in which spe has arisen */
+        std::vector<int> _number_mutated;
+
+        /** number of sub-populations in which spe arose within the time span */
+        std::vector<int> _number_mutated_within_timeSpan;
+
+        int _number_extinguished;
+
+        /** number of sub-populations in which last species arose or which extinguished */
+        int _number_lastSpecies_fate_occurred;
+
+        /** route flags (diamond configurations only) */
+        bool _has_routes;
+        std::vector<bool> _a_yielded_ab;
+        std::vector<bool> _b_yielded_ab;
+
+    private:
+
+        const bool time_greater_than_zero(const time_type &tt) const {
+
+            return mutation_occurred_within_timeSpan_detail::time_greater_than_zero(tt, time_category_type());
+        }
+
+        const bool time_less_than_LL(const time_type &tt) const {
+
+            return mutation_occurred_within_timeSpan_detail::time_less_than_LL(tt, _last_node_time, time_category_type());
+        }
+
+        const bool lastSpecies_fate_occurred(const int &pop) const {
+
+            return mutation_occurred(Pop(pop), Spe(_number_species - 1)) || extinguished(Pop(pop));
+        }
+
+    public:
+
+        /**
+         * custom constructor\n
+         * summarizes the initial configuration of a trajectory
+         */
+        explicit Trial_Summary(const Configuration_type &configuration)
+        : _number_sub_pops(configuration.number_sub_pops()),
+        _number_species(configuration.number_species()),
+        _number_first_passages(-1),
+        _last_node_time(configuration.get_last_node_time()),
+        _end(false),
+        _mutation_times(configuration.number_sub_pops(), configuration.number_species(), static_cast<time_type> (-1)),
+        _extinction_times(configuration.number_sub_pops(), static_cast<time_type> (-1)),
+        _mutation_times_whole(configuration.number_species(), static_cast<time_type> (-1)),
+        _number_mutated(configuration.number_species(), 0),
+        _number_mutated_within_timeSpan(configuration.number_species(), 0),
+        _number_extinguished(0),
+        _number_lastSpecies_fate_occurred(0),
+        _has_routes(false),
+        _a_yielded_ab(configuration.number_sub_pops(), false),
+        _b_yielded_ab(configuration.number_sub_pops(), false) {
+
+            /* check template parameter types to supplement "duck typing" */
+            BOOST_STATIC_ASSERT((boost::is_base_of<Configuration_Interface<time_type, population_type>, Configuration_type>::value));
+
+            update(configuration);
+        }
+
+        /**
+         * record first-passage data that has been generated since the last update
+         */
+        void update(const Configuration_type &configuration) {
+
+            _end = configuration.end();
+
+            /* first-passage data is unchanged unless a mutation time or extinction time was recorded */
+            const int number_first_passages = configuration.number_first_passages();
+            if (number_first_passages == _number_first_passages) return;
+            _number_first_passages = number_first_passages;
+
+            for (int pop = 0; pop < _number_sub_pops; pop++) {
+
+                const bool fate_occurred_before = lastSpecies_fate_occurred(pop);
+
+                for (int spe = 0; spe < _number_species; spe++) {
+
+                    if (mutation_occurred(Pop(pop), Spe(spe))) continue; // mutation times never change once recorded
+
+                    const time_type mutation_time = configuration.mutation_times(Pop(pop), Spe(spe));
+                    _mutation_times.at(pop, spe) = mutation_time;
+
+                    if (mutation_occurred(Pop(pop), Spe(spe))) {
+
+                        _number_mutated.at(spe)++;
+
+                        if (time_greater_than_zero(mutation_time) && time_less_than_LL(mutation_time))
+                            _number_mutated_within_timeSpan.at(spe)++;
+
+                        time_type &mutation_time_whole = _mutation_times_whole.at(spe);
+                        if ((mutation_time_whole < static_cast<time_type> (0)) || (mutation_time < mutation_time_whole))
+                            mutation_time_whole = mutation_time;
+
+                        if (spe == _number_species - 1) {
+                            bool a_yielded_ab = false;
+                            bool b_yielded_ab = false;
+                            _has_routes = trial_summary_detail::record_routes(configuration, Pop(pop), a_yielded_ab, b_yielded_ab);
+                            _a_yielded_ab.at(pop) = a_yielded_ab;
+                            _b_yielded_ab.at(pop) = b_yielded_ab;
+                        }
+                    }
+                }
+
+                if (!extinguished(Pop(pop))) { // extinct sub-populations never revive
+                    _extinction_times.at(pop) = configuration.extinction_times(Pop(pop));
+                    if (extinguished(Pop(pop))) _number_extinguished++;
+                }
+
+                if (!fate_occurred_before && lastSpecies_fate_occurred(pop))
+                    _number_lastSpecies_fate_occurred++;
+
+            }
+
+        }
+
+        /**
+         * number of sub-populations
+         */
+        const int number_sub_pops() const {
+
+            return _number_sub_pops;
+        }
+
+        /**
+         * number of species
+         */
+        const int number_species() const {
+
+            return _number_species;
+        }
+
+        /**
+         * true if end of trajectory has been reached
+         */
+        const bool end() const {
+
+            return _end;
+        }
+
+        /**
+         * time of last node in path\n
+         */
+        const time_type get_last_node_time() const {
+
+            return _last_node_time;
+        }
+
+        /**
+         * time at which first spe-type cell appeared in sub-population pop
+         */
+        const time_type mutation_times(const Pop &pop, const Spe &spe) const {
+
+            return _mutation_times.at(pop.value(), spe.value());
+        }
+
+        /**
+         * time at which sub-population pop extinguished
+         */
+        const time_type extinction_times(const Pop &pop) const {
+
+            return _extinction_times.at(pop.value());
+        }
+
+        /**
+         * returns true if species spe has arisen in sub-population pop\n
+         * a zero mutation time returns true (see monte_carlo::mutation_occurred)
+         */
+        const bool mutation_occurred(const Pop &pop, const Spe &spe) const {
+
+            return !(mutation_times(pop, spe) < static_cast<time_type> (0));
+        }
+
+        /**
+         * returns true if every species has arisen in sub-population pop
+         */
+        const bool all_mutations_occurred(const Pop &pop) const {
+
+            for (int spe = 0; spe < _number_species; spe++)
+                if (!mutation_occurred(pop, Spe(spe))) return false;
+
+            return true;
+        }
+
+        /**
+         * returns true if species spe has arisen in at least one sub-population \n
+         */
+        const bool mutation_occurred(const Spe &spe) const {
+
+            return _number_mutated.at(spe.value()) > 0;
+        }
+
+        /**
+         * returns true if species spe has arisen in all sub-populations within time span \n
+         */
+        const bool all_mutations_occurred__within_timeSpan(const Spe &spe) const {
+
+            return _number_mutated_within_timeSpan.at(spe.value()) == _number_sub_pops;
+        }
+
+        /**
+         * time at which first spe-type cell appeared in any sub-population (-1 if it has not arisen)
+         */
+        const time_type mutation_time_whole(const Spe &spe) const {
+
+            return _mutation_times_whole.at(spe.value());
+        }
+
+        /**
+         * returns true if sub-population pop has extinguished
+         */
+        const bool extinguished(const Pop &pop) const {
+
+            return extinction_times(pop) > static_cast<time_type> (0);
+        }
+
+        /**
+         * returns true if all sub-populations have extinguished
+         */
+        const bool extinguished() const {
+
+            return _number_extinguished == _number_sub_pops;
+        }
+
+        /**
+         * time at which last surviving sub-population extinguished (-1 if some sub-population survives)
+         */
+        const time_type extinction_time_whole() const {
+
+            if (!extinguished()) return static_cast<time_type> (-1);
+
+            time_type extinct_time_whole = static_cast<time_type> (-1);
+            for (int pop = 0; pop < _number_sub_pops; pop++)
+                if (_extinction_times.at(pop) > extinct_time_whole) extinct_time_whole = _extinction_times.at(pop);
+
+            return extinct_time_whole;
+        }
+
+        /**
+         * returns true if the last species arose in all sub-populations within time span
+         */
+        const bool all_last_species_occurred__within_timeSpan() const {
+
+            return all_mutations_occurred__within_timeSpan(Spe(_number_species - 1));
+        }
+
+        /**
+         * returns true if last species arose or sub-population extinguished, in all sub-populations
+         */
+        const bool eventualFateOccurred_lastSpecies_allSubPops() const {
+
+            return _number_lastSpecies_fate_occurred == _number_sub_pops;
+        }
+
+        /**
+         * returns true if penultimate species arose or sub-population extinguished, in all sub-populations
+         */
+        const bool eventualFateOccurred_penultimateSpecies_allSubPops() const {
+
+            assert(_number_species > 1);
+            const Spe penultimate_species(_number_species - 2);
+
+            for (int pop = 0; pop < _number_sub_pops; pop++)
+                if (fate(Pop(pop), penultimate_species) == -1) return false;
+
+            return true;
+        }
+
+        /**
+         * returns true if mutation_time lies in [0, time span] \n
+         * intended to be called AFTER a trajectory has been generated (see monte_carlo::mutation_occurred_within_timeSpan)
+         */
+        const bool occurred_within_timeSpan(const time_type &mutation_time) const {
+
+            if (time_greater_than_zero(mutation_time))
+                return time_less_than_LL(mutation_time);
+
+            if (!(_end || extinguished())) {
+                std::cerr << "mutation_time = " << mutation_time << std::endl;
+                std::cerr << "cannot determine if mutation occurred within time span because path was not complete" << std::endl;
+                assert(false);
+            }
+            return false;
+        }
+
+        /**
+         * returns true if species spe has arisen in sub-population pop within time span \n
+         */
+        const bool mutation_occurred_within_timeSpan(const Pop &pop, const Spe &spe) const {
+
+            return occurred_within_timeSpan(mutation_times(pop, spe));
+        }
+
+        /**
+         * returns true if species spe has arisen in any sub-population within time span \n
+         */
+        const bool mutation_occurred_within_timeSpan(const Spe &spe) const {
+
+            return occurred_within_timeSpan(mutation_time_whole(spe));
+        }
+
+        /**
+         * returns 1 if species spe arose in sub-population pop\n
+         * returns 0 if species did not arise AND sub-population extinguished\n
+         * return -1 if neither fate occurred
+         */
+        const int fate(const Pop &pop, const Spe &spe) const {
+
+            if (mutation_occurred(pop, spe)) return 1;
+            if (extinguished(pop)) return 0;
+            return -1;
+        }
+
+        /**
+         * returns 1 if species spe arose in any sub-population\n
+         * returns 0 if species did not arise in any sub-population AND entire population extinguished\n
+         * return -1 if neither fate occurred
+         */
+        const int fate(const Spe &spe) const {
+
+            if (mutation_occurred(spe)) return 1;
+            if (extinguished()) return 0;
+            return -1;
+        }
+
+        /**
+         * returns true if species spe arose in sub-population pop\n
+         * returns false if species did not arise AND sub-population extinguished\n
+         * produces error otherwise
+         */
+        const bool fate_bool(const Pop &pop, const Spe &spe) const {
+
+            const int fate_code = fate(pop, spe);
+            if (fate_code == -1) {
+                std::cerr << "pop " << pop.value() << " has not acquired spe " << spe.value() << " nor has it extinguished" << std::endl;
+                assert(false);
+            }
+            return fate_code == 1;
+        }
+
+        /**
+         * returns true if species spe arose in any sub-population\n
+         * returns false if species did not arise in any sub-population AND entire population extinguished\n
+         * produces error otherwise
+         */
+        const bool fate_bool(const Spe &spe) const {
+
+            const int fate_code = fate(spe);
+            if (fate_code == -1) {
+                std::cerr << "entire population has not acquired spe " << spe.value() << " nor has it extinguished" << std::endl;
+                assert(false);
+            }
+            return fate_code == 1;
+        }
+
+        /**
+         * true if the configuration records the route along which the last species arose (diamond configurations)
+         */
+        const bool has_routes() const {
+
+            return _has_routes;
+        }
+
+        /**
+         * true if first double mutant in sub-population pop arose from an "a" single mutant
+         */
+        const bool a_yielded_ab(const Pop &pop) const {
+
+            return _a_yielded_ab.at(pop.value());
+        }
+
+        /**
+         * true if first double mutant in sub-population pop arose from a "b" single mutant
+         */
+        const bool b_yielded_ab(const Pop &pop) const {
+
+            return _b_yielded_ab.at(pop.value());
+        }
+
+    };
+
+}
+
+#endif	/* TRIAL_SUMMARY_H */
@@ -0,0 +1,186 @@
+#ifndef CDF_SKETCH_H
+#define	CDF_SKETCH_H
+
+#include <cmath> // std::floor
+#include <fstream> // std::ofstream
+#include <iomanip> // std::setw, etc
+
+#include <mutation_accumulation/utility/data_traits.h> // data_types::discrete_type
+#include <mutation_accumulation/utility/distribution_traits.h> // distribution_types::cdf_type
+
+#include "histogram.h"
+#include "log_linear_buckets.h"
+
+/*************************************************************************/
+
+namespace probability {
+
+    /**
+     * cumulative probability distribution backed by log-linear buckets\n
+     * CDF(x) = P(X<=x) (discrete X) or P(X<x) (continuous X), as in CDF \n
+     * code assumes X >= 0 \n
+     * \n
+     * each sample costs O(log number of occupied buckets) rather than O(size of sample space), \n
+     * so a fine time grid no longer slows down every trial \n
+     * the frequency at the end of the sample space is exact (it drives convergence and observers); \n
+     * other frequencies are rebuilt from the buckets when probability is requested and carry a relative error in x of at most 2^-bits \n
+     * discrete samples smaller than 2^bits are counted exactly \n
+     * \n
+     * can be used wherever CDF is used as Histogram_Policy
+     */
+    template <class Notification_Policy, int bits = 7 >
+    class CDF_Sketch : public Histogram<typename Notification_Policy::sample_t> {
+    public:
+
+        typedef distribution_types::cdf_type category;
+
+    private:
+
+        typedef typename Notification_Policy::sample_t sample_type;
+        typedef Histogram<sample_type> base_type;
+
+    private:
+
+        Log_Linear_Buckets<sample_type> _buckets;
+
+    private:
+
+        /**
+         *  determine if sample is a valid (non-negative) sample given that sample is discrete
+         */
+        const bool valid(const sample_type &sample, data_types::discrete_type) const {
+
+            return (sample >= 0);
+        }
+
+        /**
+         *  determine if sample is a valid (non-negative) sample given that sample is continuous
+         */
+        const bool valid(const sample_type &sample, data_types::continuous_type) const {
+
+            return (sample > -1e-8); // insures that a zero mutation time is counted
+        }
+
+        /**
+         *  determine if event occurred given that sample is discrete
+         */
+        const bool event_occurred(const sample_type &sample, const sample_type &xx, data_types::discrete_type) const {
+
+            return (sample <= xx);
+        }
+
+        /**
+         *  determine if event occurred given that sample is continuous
+         */
+        const bool event_occurred(const sample_type &sample, const sample_type &xx, data_types::continuous_type) const {
+
+            return (sample < xx);
+        }
+
+        /**
+         * update CDF and notify observers
+         */
+        virtual void updateHistogram_notify(const sample_type &sample) {
+
+            typename data_types::data_traits<sample_type>::category sample_category;
+
+            if (valid(sample, sample_category)) {
+
+                /* add sample to buckets */
+                _buckets.insert(sample > 0 ? sample : static_cast<sample_type> (0));
+
+                /* keep end frequency exact */
+                const int last = this->get_sample_space().size() - 1;
+                if (event_occurred(sample, this->get_sample_space().at(last), sample_category))
+                    this->increment_histogram(last);
+            }
+
+            /* notify observers */
+            if (Notification_Policy::notify(sample, this->get_sample_space()))
+                this->notify();
+
+        }
+
+        /**
+         * rebuild all but the end frequency from the buckets, in one pass over the buckets
+         */
+        virtual void synchronize() const {
+
+            const std::vector<sample_type> &sample_space = this->get_sample_space();
+            const std::vector<double> counts = _buckets.count_below(sample_space);
+            const typename base_type::frequency_t end_frequency = this->get_end_frequency();
+
+            for (typename std::vector<sample_type>::size_type ii = 0; ii + 1 < sample_space.size(); ii++) {
+                typename base_type::frequency_t frequency = static_cast<typename base_type::frequency_t> (std::floor(counts.at(ii) + 0.5));
+                if (frequency > end_frequency) frequency = end_frequency;
+                this->set_frequency(ii, frequency);
+            }
+
+        }
+
+    public:
+
+        /**
+         * constructor
+         */
+        explicit CDF_Sketch(const std::vector<sample_type> &sample_space_, const std::string &fileName)
+        : base_type(sample_space_, fileName), _buckets(bits) {
+
+        }
+
+        /**
+         * default constructor
+         */
+        explicit CDF_Sketch() : base_type(), _buckets(bits) {
+
+        }
+
+        /**
+         * virtual destructor \n
+         * stores probability while the buckets still exist (see Histogram::synchronize)
+         */
+        virtual ~CDF_Sketch() {
+
+            if (!this->get_sample_space().empty()) this->store();
+        }
+
+        /**
+         * approximate q-quantile of the non-negative samples seen so far
+         */
+        const double quantile(const double &qq) const {
+
+            return _buckets.quantile(qq);
+        }
+
+        /**
+         * write CDF evaluated on an arbitrary grid (sorted in increasing order) to disk \n
+         * the grid need not coincide with the sample space, nor lie within it
+         */
+        void export_cdf(const std::vector<sample_type> &grid, const std::string &fileName) const {
+
+            const boost::shared_ptr<std::ofstream> ofstream_ptr = monte_carlo::open_file_for_output(fileName);
+
+            const std::vector<double> counts = _buckets.count_below(grid);
+            const double number_trials = static_cast<double> (this->get_number_trials());
+            for (int ii = 0; ii < grid.size(); ii++) {
+
+                *ofstream_ptr << std::setw(10) << std::setprecision(3) << grid.at(ii);
+                *ofstream_ptr << std::setw(20) << std::setprecision(10) << (number_trials > 0.0 ? counts.at(ii) / number_trials : 0.0);
+                *ofstream_ptr << std::endl;
+
+            }
+        }
+
+        /**
+         * buckets holding the non-negative samples seen so far (e.g. to merge runs)
+         */
+        const Log_Linear_Buckets<sample_type> &buckets() const {
+
+            return _buckets;
+        }
+    };
+
+}
+
+
+#endif	/* CDF_SKETCH_H */
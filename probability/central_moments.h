@@ -0,0 +1,156 @@
+#ifndef CENTRAL_MOMENTS_H
+#define	CENTRAL_MOMENTS_H
+
+#include <cmath> // std::sqrt, std::pow
+#include <cassert> // assert
+
+#include "moment.h" // probability::Moment
+
+/*************************************************************************/
+
+namespace probability {
+
+    /**
+     * calculate mean, variance, skewness and kurtosis from ensemble of samples \n
+     * value() is the mean, so this class may be used wherever Mean is used \n
+     * \n
+     * central moment sums are updated in a single pass with the numerically stable recurrences of Pebay (2008); \n
+     * estimates from independent runs can be merged; merging is associative
+     */
+    template <class sample_type>
+    class Central_Moments : public Moment<sample_type> {
+    private:
+
+        long long int _number_trials;
+        double _mean;
+        double _M2; // sum of squared deviations from mean
+        double _M3; // sum of cubed deviations from mean
+        double _M4; // sum of fourth powers of deviations from mean
+
+    public:
+
+        /**
+         * custom ctor
+         */
+        explicit Central_Moments() : _number_trials(0), _mean(0.0), _M2(0.0), _M3(0.0), _M4(0.0) {
+
+        }
+
+        /**
+         * update estimate of moments
+         */
+        virtual void update(const sample_type &sample) {
+
+            const double n1 = static_cast<double> (_number_trials);
+            _number_trials++;
+            const double nn = static_cast<double> (_number_trials);
+
+            const double delta = static_cast<double> (sample) - _mean;
+            const double delta_n = delta / nn;
+            const double delta_n2 = delta_n * delta_n;
+            const double term1 = delta * delta_n * n1;
+
+            _mean += delta_n;
+            _M4 += term1 * delta_n2 * (nn * nn - 3.0 * nn + 3.0) + 6.0 * delta_n2 * _M2 - 4.0 * delta_n * _M3;
+            _M3 += term1 * delta_n * (nn - 2.0) - 3.0 * delta_n * _M2;
+            _M2 += term1;
+
+        }
+
+        /**
+         * add the samples of an independent estimate
+         */
+        void merge(const Central_Moments &other) {
+
+            if (other._number_trials == 0) return;
+
+            const double na = static_cast<double> (_number_trials);
+            const double nb = static_cast<double> (other._number_trials);
+            const double nn = na + nb;
+
+            const double delta = other._mean - _mean;
+            const double delta2 = delta * delta;
+            const double delta3 = delta * delta2;
+            const double delta4 = delta2 * delta2;
+
+            const double M2 = _M2 + other._M2 + delta2 * na * nb / nn;
+            const double M3 = _M3 + other._M3 + delta3 * na * nb * (na - nb) / (nn * nn)
+                    + 3.0 * delta * (na * other._M2 - nb * _M2) / nn;
+            const double M4 = _M4 + other._M4 + delta4 * na * nb * (na * na - na * nb + nb * nb) / (nn * nn * nn)
+                    + 6.0 * delta2 * (na * na * other._M2 + nb * nb * _M2) / (nn * nn)
+                    + 4.0 * delta * (na * other._M3 - nb * _M3) / nn;
+
+            _mean += delta * nb / nn;
+            _M2 = M2;
+            _M3 = M3;
+            _M4 = M4;
+            _number_trials += other._number_trials;
+
+        }
+
+        /**
+         * get mean
+         */
+        virtual const double value() const {
+
+            if (_number_trials > 0)
+                return _mean;
+            else
+                assert(false);
+        }
+
+        /**
+         * unbiased estimate of variance of samples
+         */
+        const double variance() const {
+
+            if (_number_trials > 1)
+                return _M2 / static_cast<double> (_number_trials - 1);
+            else
+                return 0.0;
+        }
+
+        /**
+         * sample skewness
+         */
+        const double skewness() const {
+
+            assert(_M2 > 0.0);
+
+            return std::sqrt(static_cast<double> (_number_trials)) * _M3 / std::pow(_M2, 1.5);
+        }
+
+        /**
+         * sample excess kurtosis (zero for a normal distribution)
+         */
+        const double kurtosis() const {
+
+            assert(_M2 > 0.0);
+
+            return static_cast<double> (_number_trials) * _M4 / (_M2 * _M2) - 3.0;
+        }
+
+        /**
+         * standard error of mean
+         */
+        virtual const double standard_error() const {
+
+            if (_number_trials > 0)
+                return std::sqrt(variance() / static_cast<double> (_number_trials));
+            else
+                assert(false);
+        }
+
+        /**
+         * return number trials
+         */
+        virtual const long long int trials() const {
+
+            return _number_trials;
+        }
+
+    };
+
+}
+
+#endif	/* CENTRAL_MOMENTS_H */
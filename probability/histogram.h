@@ -74,8 +74,9 @@ namespace probability {
     private:
 
         const std::vector<sample_type> sample_space;
-        std::vector<frequency_t> histogram;
-        std::vector<double> probability;
+        mutable std::vector<frequency_t> histogram; // mutable so that derived classes can synchronize lazily
+        mutable std::vector<double> probability; // normalized lazily, when probability is requested
+        mutable bool probability_is_stale;
         number_trials_t number_trials;
 
         const std::string _fileName;
@@ -95,9 +96,12 @@ namespace probability {
         /* implementation member functions available to Histogram */
 
         /**
-         * normalize histogram
+         * normalize histogram\n
+         * called only when probability is requested, rather than after every sample (O(size of sample space))
          */
-        void normalize() {
+        void normalize() const {
+
+            synchronize();
 
             if (number_trials > static_cast<number_trials_t>(0)) {
 
@@ -105,23 +109,8 @@ namespace probability {
                     probability.at(ii) = (double) histogram.at(ii) / (double) number_trials;
             }
 
-        }
-
-        /**
-         * write probability to disk
-         */
-        void store() {
+            probability_is_stale = false;
 
-            /* open file for (over-)writing */
-            const boost::shared_ptr<std::ofstream> ofstream_ptr = monte_carlo::open_file_for_output(_fileName);
-
-            for (int ii = 0; ii < probability.size(); ii++) {
-
-                *ofstream_ptr << std::setw(10) << std::setprecision(3) << sample_space.at(ii);
-                *ofstream_ptr << std::setw(20) << std::setprecision(10) << probability.at(ii);
-                *ofstream_ptr << std::endl;
-
-            }
         }
 
         /**
@@ -155,7 +144,7 @@ namespace probability {
          * constructor
          */
         explicit Histogram(const std::vector<sample_type> &sample_space_, const std::string &fileName)
-        : patterns::Subject(), sample_space(sample_space_), number_trials(static_cast<number_trials_t>(0)), _fileName(fileName) {
+        : patterns::Subject(), sample_space(sample_space_), probability_is_stale(false), number_trials(static_cast<number_trials_t>(0)), _fileName(fileName) {
 
             histogram = std::vector<frequency_t>(sample_space_.size(), 0);
             probability = std::vector<double>(sample_space_.size(), -1.0);
@@ -172,7 +161,7 @@ namespace probability {
          * this is an empty constructor\n
          * compiler should generate code to construct private data members (Item 30)
          */
-        explicit Histogram() {
+        explicit Histogram() : probability_is_stale(false) {
 
         }
 
@@ -186,6 +175,44 @@ namespace probability {
 
         }
 
+        /**
+         * overwrite frequency at position ii\n
+         * intended for use in synchronize()
+         */
+        void set_frequency(const int &ii, const frequency_t &frequency) const {
+
+            histogram.at(ii) = frequency;
+
+        }
+
+        /**
+         * bring frequencies up to date before they are normalized\n
+         * histograms that update their frequencies eagerly need not override this \n
+         * histograms that override this should call store() in their own destructor, \n
+         * since virtual calls from the base-class destructor do not reach derived classes
+         */
+        virtual void synchronize() const {
+
+        }
+
+        /**
+         * write probability to disk
+         */
+        void store() const {
+
+            /* open file for (over-)writing */
+            const boost::shared_ptr<std::ofstream> ofstream_ptr = monte_carlo::open_file_for_output(_fileName);
+
+            const std::vector<double> &probability_ = get_probability();
+            for (int ii = 0; ii < probability_.size(); ii++) {
+
+                *ofstream_ptr << std::setw(10) << std::setprecision(3) << sample_space.at(ii);
+                *ofstream_ptr << std::setw(20) << std::setprecision(10) << probability_.at(ii);
+                *ofstream_ptr << std::endl;
+
+            }
+        }
+
 
         /**
          * update histogram of frequencies and notify any observers
@@ -219,8 +246,8 @@ namespace probability {
                 /* update histogram of frequencies and notify any observers */
                 updateHistogram_notify(sample);
 
-                /* update probabilities */
-                normalize();
+                /* probabilities are normalized when next requested */
+                probability_is_stale = true;
             }
 
             /* write current state to disk at regular intervals */
@@ -234,6 +261,8 @@ namespace probability {
          */
         const frequency_t get_largest_frequency() const {
 
+            synchronize();
+
             return *(std::max_element(histogram.begin(), histogram.end()));
 
         }
@@ -248,9 +277,10 @@ namespace probability {
         }
 
         /**
-         * get sample space
+         * get sample space \n
+         * returned by reference, since derived classes query the sample space for every sample
          */
-        const std::vector<sample_type> get_sample_space() const {
+        const std::vector<sample_type> &get_sample_space() const {
 
             return sample_space;
 
@@ -259,7 +289,9 @@ namespace probability {
         /**
          * get probability
          */
-        const std::vector<double> get_probability() const {
+        const std::vector<double> &get_probability() const {
+
+            if (probability_is_stale) normalize();
 
             return probability;
 
@@ -274,6 +306,37 @@ namespace probability {
 
         }
 
+        /**
+         * get frequencies of sample space
+         */
+        const std::vector<frequency_t> &get_frequencies() const {
+
+            synchronize();
+
+            return histogram;
+
+        }
+
+        /**
+         * add the frequencies and number of trials of an independent run with the same sample space \n
+         * observers are not notified \n
+         * histograms that override synchronize() rebuild their frequencies from other state, so cannot be merged this way
+         */
+        void merge_frequencies(const std::vector<frequency_t> &frequencies, const number_trials_t &number_trials_) {
+
+            if (frequencies.size() != histogram.size()) {
+                std::cerr << "cannot merge histograms with different sample spaces" << std::endl;
+                assert(false);
+            }
+
+            for (int ii = 0; ii < histogram.size(); ii++)
+                histogram.at(ii) += frequencies.at(ii);
+            number_trials += number_trials_;
+
+            probability_is_stale = true;
+
+        }
+
     };
 
 
@@ -0,0 +1,266 @@
+#ifndef LOG_LINEAR_BUCKETS_H
+#define	LOG_LINEAR_BUCKETS_H
+
+#include <map> // std::map
+#include <vector> // std::vector
+#include <cmath> // std::frexp, std::ldexp, std::floor
+#include <limits> // std::numeric_limits
+#include <cassert> // assert
+
+#include <mutation_accumulation/utility/data_traits.h> // data_types::discrete_type, etc
+
+/*************************************************************************/
+
+namespace probability {
+
+    namespace log_linear_buckets_detail {
+
+        typedef long long int key_type;
+
+        /**
+         * bucket holding exact zeros of a continuous sample type
+         */
+        inline const key_type zero_key() {
+
+            return std::numeric_limits<key_type>::min();
+        }
+
+        /**
+         * bucket of a non-negative discrete sample \n
+         * samples below 2^bits have their own bucket (exact); \n
+         * each octave [2^e, 2^(e+1)) above is split into 2^bits equal buckets
+         */
+        template <class sample_type>
+        const key_type bucket_key(const sample_type &sample, const int &bits, data_types::discrete_type) {
+
+            const key_type vv = static_cast<key_type> (sample);
+            const key_type linear_limit = static_cast<key_type> (1) << bits;
+            if (vv < linear_limit) return vv;
+
+            int exponent = 0;
+            while ((vv >> exponent) >= 2 * linear_limit) exponent++; // vv >> exponent lies in [2^bits, 2^(bits+1))
+
+            return linear_limit * (exponent + 1) + ((vv >> exponent) - linear_limit);
+        }
+
+        /**
+         * bounds [lower, upper) of the values of a discrete bucket
+         */
+        template <class sample_type>
+        void bucket_bounds(const key_type &key, const int &bits, double &lower, double &upper, data_types::discrete_type) {
+
+            const key_type linear_limit = static_cast<key_type> (1) << bits;
+            if (key < linear_limit) {
+                lower = static_cast<double> (key);
+                upper = lower + 1.0;
+                return;
+            }
+
+            const int exponent = static_cast<int> (key / linear_limit) - 1;
+            const key_type sub_bucket = key % linear_limit;
+            lower = std::ldexp(static_cast<double> (linear_limit + sub_bucket), exponent);
+            upper = std::ldexp(static_cast<double> (linear_limit + sub_bucket + 1), exponent);
+        }
+
+        /**
+         * bucket of a non-negative continuous sample \n
+         * each octave [2^(e-1), 2^e) is split into 2^bits equal buckets, so the relative width of a bucket is at most 2^-bits
+         */
+        template <class sample_type>
+        const key_type bucket_key(const sample_type &sample, const int &bits, data_types::continuous_type) {
+
+            if (!(sample > 0.0)) return zero_key();
+
+            int exponent;
+            const double mantissa = std::frexp(static_cast<double> (sample), &exponent); // sample = mantissa * 2^exponent, mantissa in [0.5, 1)
+            const key_type linear_limit = static_cast<key_type> (1) << bits;
+            key_type sub_bucket = static_cast<key_type> (std::floor((2.0 * mantissa - 1.0) * linear_limit));
+            if (sub_bucket >= linear_limit) sub_bucket = linear_limit - 1; // guard against rounding
+
+            return linear_limit * exponent + sub_bucket;
+        }
+
+        /**
+         * bounds [lower, upper) of the values of a continuous bucket
+         */
+        template <class sample_type>
+        void bucket_bounds(const key_type &key, const int &bits, double &lower, double &upper, data_types::continuous_type) {
+
+            if (key == zero_key()) {
+                lower = 0.0;
+                upper = 0.0;
+                return;
+            }
+
+            const key_type linear_limit = static_cast<key_type> (1) << bits;
+            key_type exponent = key / linear_limit;
+            key_type sub_bucket = key % linear_limit;
+            if (sub_bucket < 0) { // C++ division truncates towards zero
+                sub_bucket += linear_limit;
+                exponent -= 1;
+            }
+
+            lower = std::ldexp(1.0 + static_cast<double> (sub_bucket) / linear_limit, static_cast<int> (exponent) - 1);
+            upper = std::ldexp(1.0 + static_cast<double> (sub_bucket + 1) / linear_limit, static_cast<int> (exponent) - 1);
+        }
+
+        /**
+         * fraction of a discrete bucket's samples that are no larger than xx (samples are spread uniformly over the bucket's integers)
+         */
+        inline const double fraction_below(const double &xx, const double &lower, const double &upper, data_types::discrete_type) {
+
+            if (xx < lower) return 0.0;
+            if (xx >= upper - 1.0) return 1.0;
+            return (std::floor(xx) - lower + 1.0) / (upper - lower);
+        }
+
+        /**
+         * fraction of a continuous bucket's samples that are smaller than xx (samples are spread uniformly over the bucket)
+         */
+        inline const double fraction_below(const double &xx, const double &lower, const double &upper, data_types::continuous_type) {
+
+            if (!(xx > lower)) return 0.0;
+            if (xx >= upper) return 1.0;
+            return (xx - lower) / (upper - lower);
+        }
+
+    }
+
+    /**
+     * sparse log-linear (HDR-style) histogram of non-negative samples\n
+     * values are bucketed with relative resolution 2^-bits over an unbounded range, \n
+     * so memory is bounded by the number of occupied buckets (about 2^bits per octave of the data) \n
+     * \n
+     * discrete samples smaller than 2^bits are counted exactly \n
+     * buckets from independent runs can be merged \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    template <class sample_type>
+    class Log_Linear_Buckets {
+    public:
+
+        typedef sample_type sample_t;
+        typedef long long int frequency_t;
+
+    private:
+
+        typedef log_linear_buckets_detail::key_type key_type;
+        typedef typename data_types::data_traits<sample_type>::category sample_category_type;
+        typedef std::map<key_type, frequency_t> buckets_type;
+
+    private:
+
+        int _bits;
+        buckets_type _buckets;
+        frequency_t _number_samples;
+
+    public:
+
+        /**
+         * constructor
+         */
+        explicit Log_Linear_Buckets(const int &bits_ = 7) : _bits(bits_), _number_samples(0) {
+
+            assert(_bits > 0 && _bits < 30);
+        }
+
+        /**
+         * add a non-negative sample
+         */
+        void insert(const sample_type &sample) {
+
+            _buckets[log_linear_buckets_detail::bucket_key(sample, _bits, sample_category_type())]++;
+            _number_samples++;
+        }
+
+        /**
+         * add the samples of another set of buckets with the same resolution
+         */
+        void merge(const Log_Linear_Buckets &other) {
+
+            assert(other._bits == _bits);
+
+            for (typename buckets_type::const_iterator it = other._buckets.begin(); it != other._buckets.end(); ++it)
+                _buckets[it->first] += it->second;
+            _number_samples += other._number_samples;
+        }
+
+        /**
+         * number of samples
+         */
+        const frequency_t number_samples() const {
+
+            return _number_samples;
+        }
+
+        /**
+         * number of occupied buckets
+         */
+        const int number_buckets() const {
+
+            return _buckets.size();
+        }
+
+        /**
+         * approximate number of samples no larger than xx (discrete) or smaller than xx (continuous), \n
+         * evaluated on a grid that is sorted in increasing order, in a single pass over the buckets
+         */
+        const std::vector<double> count_below(const std::vector<sample_type> &grid) const {
+
+            std::vector<double> counts(grid.size(), 0.0);
+
+            typename buckets_type::const_iterator it = _buckets.begin();
+            double cumulative = 0.0; // samples in buckets that lie wholly below current grid point
+            for (typename std::vector<sample_type>::size_type ii = 0; ii < grid.size(); ii++) {
+
+                assert(ii == 0 || !(grid.at(ii) < grid.at(ii - 1)));
+                const double xx = static_cast<double> (grid.at(ii));
+
+                /* absorb buckets that lie wholly below xx */
+                double lower, upper;
+                while (it != _buckets.end()) {
+                    log_linear_buckets_detail::bucket_bounds<sample_type > (it->first, _bits, lower, upper, sample_category_type());
+                    if (log_linear_buckets_detail::fraction_below(xx, lower, upper, sample_category_type()) < 1.0) break;
+                    cumulative += it->second;
+                    ++it;
+                }
+
+                /* add partial contribution of bucket containing xx */
+                double partial = 0.0;
+                if (it != _buckets.end())
+                    partial = it->second * log_linear_buckets_detail::fraction_below(xx, lower, upper, sample_category_type());
+
+                counts.at(ii) = cumulative + partial;
+            }
+
+            return counts;
+        }
+
+        /**
+         * approximate q-quantile of the samples, 0 <= q <= 1 (interpolated linearly within a bucket)
+         */
+        const double quantile(const double &qq) const {
+
+            assert(_number_samples > 0);
+            assert(qq >= 0.0 && qq <= 1.0);
+
+            const double target = qq * _number_samples;
+            double cumulative = 0.0;
+            double lower = 0.0, upper = 0.0;
+            for (typename buckets_type::const_iterator it = _buckets.begin(); it != _buckets.end(); ++it) {
+                log_linear_buckets_detail::bucket_bounds<sample_type > (it->first, _bits, lower, upper, sample_category_type());
+                if (cumulative + it->second >= target) {
+                    const double fraction = (target - cumulative) / it->second;
+                    return lower + fraction * (upper - lower);
+                }
+                cumulative += it->second;
+            }
+
+            return upper;
+        }
+
+    };
+
+}
+
+#endif	/* LOG_LINEAR_BUCKETS_H */
@@ -1,6 +1,7 @@
 #ifndef MEAN_CLASS_H
 #define	MEAN_CLASS_H
 
+#include <cmath> // std::sqrt
 #include <cassert> // assert
 
 #include "moment.h" // probability::Moment 
@@ -13,12 +14,17 @@ namespace probability {
      * calculate mean from ensemble of samples \n
      * may decorate this class to estimate convergence (Joshi's book pp 72 - 81)\n
      * use template arguments instead of Joshi's wrapper class to make decorator\n
+     * \n
+     * mean and sum of squared deviations are updated with Welford's algorithm, \n
+     * which does not lose precision when the mean is large compared to the spread \n
+     * estimates from independent runs can be merged (Chan et al.); merging is associative
      */
     template <class sample_type>
     class Mean : public Moment<sample_type> {
     private:
 
-        sample_type _running_sum;
+        double _mean;
+        double _sum_squared_deviations;
         long long int _number_trials;
         
     public:
@@ -26,7 +32,7 @@ namespace probability {
         /** 
          * custom ctor 
          */
-        explicit Mean() : _running_sum(static_cast<sample_type>(0)), _number_trials(0) {
+        explicit Mean() : _mean(0.0), _sum_squared_deviations(0.0), _number_trials(0) {
             
         }
         
@@ -35,9 +41,30 @@ namespace probability {
          */
         virtual void update(const sample_type &sample) {
 
-            _running_sum += sample; 
             _number_trials++; 
 
+            const double delta = static_cast<double> (sample) - _mean;
+            _mean += delta / static_cast<double> (_number_trials);
+            _sum_squared_deviations += delta * (static_cast<double> (sample) - _mean);
+
+        }
+
+        /**
+         * add the samples of an independent estimate
+         */
+        void merge(const Mean &other) {
+
+            if (other._number_trials == 0) return;
+
+            const double number_trials_this = static_cast<double> (_number_trials);
+            const double number_trials_other = static_cast<double> (other._number_trials);
+            const double number_trials = number_trials_this + number_trials_other;
+            const double delta = other._mean - _mean;
+
+            _mean += delta * number_trials_other / number_trials;
+            _sum_squared_deviations += other._sum_squared_deviations + delta * delta * number_trials_this * number_trials_other / number_trials;
+            _number_trials += other._number_trials;
+
         }
 
         /**
@@ -46,11 +73,33 @@ namespace probability {
         virtual const double value() const {
             
             if (_number_trials > 0) 
-                return _running_sum/static_cast<double>(_number_trials);
+                return _mean;
             else 
                 assert(false);
         }
 
+        /**
+         * unbiased estimate of variance of samples
+         */
+        const double variance() const {
+
+            if (_number_trials > 1)
+                return _sum_squared_deviations / static_cast<double> (_number_trials - 1);
+            else
+                return 0.0;
+        }
+
+        /**
+         * standard error of mean
+         */
+        virtual const double standard_error() const {
+
+            if (_number_trials > 0)
+                return std::sqrt(variance() / static_cast<double> (_number_trials));
+            else
+                assert(false);
+        }
+
         /**
          * return number trials
          */
@@ -70,4 +119,3 @@ namespace probability {
 
 #endif	/* MEAN_CLASS_H */
 
-
@@ -37,6 +37,11 @@ namespace probability {
          */
         virtual const Results_t value() const = 0;
 
+        /**
+         * standard error of moment, used to decide when enough samples have been taken
+         */
+        virtual const double standard_error() const = 0;
+
         /**
          * return number trials
          */
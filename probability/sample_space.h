@@ -74,6 +74,50 @@ namespace probability {
 
     };
 
+    /**
+     * create log-linear sample space of discrete type starting at zero\n
+     * every integer below 2^bits is a sample point; above that, each octave [2^e, 2^(e+1)) contributes \n
+     * the largest integer of each of its 2^bits equal sub-intervals, so a discrete CDF is exact at each sample point \n
+     * and the spacing relative to the sample value is at most 2^-bits \n
+     * the span of the sample space is always the last sample point \n
+     * \n
+     * sample points coincide with bucket boundaries of Log_Linear_Buckets with at least as many bits, \n
+     * so CDF_Sketch on this sample space is exact at every sample point \n
+     * size of sample space grows as 2^bits * log2(span), rather than as span; \n
+     * histograms still store dense frequencies and probabilities over the whole sample space, \n
+     * so memory per histogram scales with the size of the sample space, not with the number of occupied sample points
+     */
+    template <class sample_type>
+    class Make_Log_Linear_Sample_Space {
+    public:
+
+        typedef sample_type sample_t;
+
+        static const std::vector<sample_type> build(
+                const int &bits,
+                const sample_type &span_of_sample_space) {
+
+            const sample_type linear_limit = static_cast<sample_type> (1) << bits;
+
+            std::vector<sample_type> sample_space;
+            for (sample_type xx = 0; xx < linear_limit && xx < span_of_sample_space; xx++)
+                sample_space.push_back(xx);
+
+            for (sample_type width = 1; linear_limit * width < span_of_sample_space; width *= 2)
+                for (sample_type kk = 0; kk < linear_limit; kk++) {
+                    const sample_type xx = linear_limit * width + (kk + 1) * width - 1;
+                    if (xx >= span_of_sample_space) break;
+                    sample_space.push_back(xx);
+                }
+
+            sample_space.push_back(span_of_sample_space);
+
+            return sample_space;
+
+        }
+
+    };
+
 }
 
 #endif	/* SAMPLE_SPACE_H */
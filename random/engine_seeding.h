@@ -0,0 +1,50 @@
+#ifndef ENGINE_SEEDING_H
+#define	ENGINE_SEEDING_H
+
+#include <cassert> // assert
+
+#include <boost/cstdint.hpp> // boost::uint64_t, boost::uint32_t
+
+/*************************************************************************/
+
+namespace mutation_accumulation {
+
+    namespace random {
+
+        /**
+         * helpers shared by the engines of this directory (see xoshiro256pp, pcg64)
+         */
+        namespace engine_seeding_detail {
+
+            /**
+             * next output of the SplitMix64 sequence (Steele, Lea and Flood 2014) with the given state \n
+             * expands a single seed value into well-mixed state words, as recommended by the authors of xoshiro
+             */
+            inline const boost::uint64_t splitmix64(boost::uint64_t &state) {
+
+                state += 0x9E3779B97F4A7C15ULL;
+                boost::uint64_t zz = state;
+                zz = (zz ^ (zz >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                zz = (zz ^ (zz >> 27)) * 0x94D049BB133111EBULL;
+                return zz ^ (zz >> 31);
+            }
+
+            /**
+             * fill number_words (at most 4) 64-bit words from a seed sequence (e.g. boost::random::seed_seq)
+             */
+            template <class SeedSeq>
+            void generate_words(SeedSeq &seed_sequence, boost::uint64_t *words, const int &number_words) {
+
+                assert(number_words <= 4);
+
+                boost::uint32_t halves[8];
+                seed_sequence.generate(halves, halves + 2 * number_words);
+                for (int ii = 0; ii < number_words; ii++)
+                    words[ii] = static_cast<boost::uint64_t> (halves[2 * ii]) | (static_cast<boost::uint64_t> (halves[2 * ii + 1]) << 32);
+            }
+
+        }
+    }
+}
+
+#endif	/* ENGINE_SEEDING_H */
@@ -0,0 +1,145 @@
+#ifndef PCG64_H
+#define	PCG64_H
+
+#include <boost/cstdint.hpp> // boost::uint64_t
+#include <boost/type_traits/is_arithmetic.hpp> // boost::is_arithmetic
+#include <boost/type_traits/is_same.hpp> // boost::is_same
+#include <boost/utility/enable_if.hpp> // boost::disable_if
+
+#include "engine_seeding.h" // mutation_accumulation::random::engine_seeding_detail::splitmix64, etc
+
+/*************************************************************************/
+
+namespace mutation_accumulation {
+
+    namespace random {
+
+        /**
+         * PCG64 generator of O'Neill (2014): a 128-bit linear congruential generator \n
+         * whose high and low halves are xor-folded and randomly rotated (XSL RR) into 64-bit outputs; \n
+         * the increment selects one of 2^127 streams \n
+         * models a uniform random number generator, seeded like the engines of boost::random \n
+         * (from a single value, expanded by SplitMix64, or from a seed sequence) \n
+         * requires a compiler that provides 128-bit unsigned integers (gcc and clang on 64-bit targets) \n
+         * compiler-generated copy constructor and assignment operator are fine
+         */
+        class pcg64 {
+        public:
+
+            typedef boost::uint64_t result_type;
+
+            /**
+             * enum hack (Item 2)
+             */
+            enum {
+                default_seed = 5489
+            };
+
+        private:
+
+            typedef unsigned __int128 state_type;
+
+            state_type _state;
+            state_type _increment;
+
+            static const state_type multiplier() {
+
+                return (static_cast<state_type> (2549297995355413924ULL) << 64) | static_cast<state_type> (4865540595714422341ULL);
+            }
+
+            void step() {
+
+                _state = _state * multiplier() + _increment;
+            }
+
+            /**
+             * set state and stream as in pcg_setseq_128_srandom_r of the reference implementation
+             */
+            void set_state(const boost::uint64_t *words) {
+
+                _increment = (((static_cast<state_type> (words[2]) << 64) | static_cast<state_type> (words[3])) << 1) | static_cast<state_type> (1);
+                _state = 0;
+                step();
+                _state += (static_cast<state_type> (words[0]) << 64) | static_cast<state_type> (words[1]);
+                step();
+            }
+
+            /**
+             * seed from a single value
+             */
+            template <class Seed>
+            void seed(const Seed &value, const boost::true_type) {
+
+                boost::uint64_t state = static_cast<boost::uint64_t> (value);
+                boost::uint64_t words[4];
+                for (int ii = 0; ii < 4; ii++)
+                    words[ii] = engine_seeding_detail::splitmix64(state);
+                set_state(words);
+            }
+
+            /**
+             * seed from a seed sequence
+             */
+            template <class SeedSeq>
+            void seed(SeedSeq &seed_sequence, const boost::false_type) {
+
+                boost::uint64_t words[4];
+                engine_seeding_detail::generate_words(seed_sequence, words, 4);
+                set_state(words);
+            }
+
+        public:
+
+            explicit pcg64(const boost::uint64_t &value = default_seed) {
+
+                seed(value);
+            }
+
+            /**
+             * seed from a single value or a seed sequence (not another generator, which is copied)
+             */
+            template <class Seed>
+            explicit pcg64(Seed &seed_, typename boost::disable_if<boost::is_same<Seed, pcg64> >::type * = 0) {
+
+                seed(seed_);
+            }
+
+            void seed(const boost::uint64_t &value) {
+
+                seed(value, boost::true_type());
+            }
+
+            /**
+             * dispatch on whether the argument is a value or a seed sequence
+             */
+            template <class Seed>
+            void seed(Seed &seed_) {
+
+                typename boost::is_arithmetic<Seed>::type seed_category;
+                seed(seed_, seed_category);
+            }
+
+            static const result_type min() {
+
+                return 0;
+            }
+
+            static const result_type max() {
+
+                return ~static_cast<result_type> (0);
+            }
+
+            const result_type operator()() {
+
+                step();
+
+                const boost::uint64_t folded = static_cast<boost::uint64_t> (_state >> 64) ^ static_cast<boost::uint64_t> (_state);
+                const int rotation = static_cast<int> (_state >> 122);
+                return (folded >> rotation) | (folded << ((-rotation) & 63));
+            }
+
+        };
+    }
+}
+
+#endif	/* PCG64_H */
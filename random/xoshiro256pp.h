@@ -0,0 +1,127 @@
+#ifndef XOSHIRO256PP_H
+#define	XOSHIRO256PP_H
+
+#include <boost/cstdint.hpp> // boost::uint64_t
+#include <boost/type_traits/is_arithmetic.hpp> // boost::is_arithmetic
+#include <boost/type_traits/is_same.hpp> // boost::is_same
+#include <boost/utility/enable_if.hpp> // boost::disable_if
+
+#include "engine_seeding.h" // mutation_accumulation::random::engine_seeding_detail::splitmix64, etc
+
+/*************************************************************************/
+
+namespace mutation_accumulation {
+
+    namespace random {
+
+        /**
+         * xoshiro256++ generator of Blackman and Vigna (2019): 64-bit outputs from 32 bytes of state, period 2^256 - 1 \n
+         * models a uniform random number generator, seeded like the engines of boost::random \n
+         * (from a single value, expanded by SplitMix64, or from a seed sequence) \n
+         * compiler-generated copy constructor and assignment operator are fine
+         */
+        class xoshiro256pp {
+        public:
+
+            typedef boost::uint64_t result_type;
+
+            /**
+             * enum hack (Item 2)
+             */
+            enum {
+                default_seed = 5489
+            };
+
+        private:
+
+            boost::uint64_t _state[4];
+
+            static const boost::uint64_t rotl(const boost::uint64_t &xx, const int &kk) {
+
+                return (xx << kk) | (xx >> (64 - kk));
+            }
+
+            /**
+             * seed from a single value
+             */
+            template <class Seed>
+            void seed(const Seed &value, const boost::true_type) {
+
+                boost::uint64_t state = static_cast<boost::uint64_t> (value);
+                for (int ii = 0; ii < 4; ii++)
+                    _state[ii] = engine_seeding_detail::splitmix64(state);
+            }
+
+            /**
+             * seed from a seed sequence \n
+             * the all-zero state is the one state that must be avoided
+             */
+            template <class SeedSeq>
+            void seed(SeedSeq &seed_sequence, const boost::false_type) {
+
+                engine_seeding_detail::generate_words(seed_sequence, _state, 4);
+                if ((_state[0] | _state[1] | _state[2] | _state[3]) == 0) seed(static_cast<boost::uint64_t> (default_seed), boost::true_type());
+            }
+
+        public:
+
+            explicit xoshiro256pp(const boost::uint64_t &value = default_seed) {
+
+                seed(value);
+            }
+
+            /**
+             * seed from a single value or a seed sequence (not another generator, which is copied)
+             */
+            template <class Seed>
+            explicit xoshiro256pp(Seed &seed_, typename boost::disable_if<boost::is_same<Seed, xoshiro256pp> >::type * = 0) {
+
+                seed(seed_);
+            }
+
+            void seed(const boost::uint64_t &value) {
+
+                seed(value, boost::true_type());
+            }
+
+            /**
+             * dispatch on whether the argument is a value or a seed sequence
+             */
+            template <class Seed>
+            void seed(Seed &seed_) {
+
+                typename boost::is_arithmetic<Seed>::type seed_category;
+                seed(seed_, seed_category);
+            }
+
+            static const result_type min() {
+
+                return 0;
+            }
+
+            static const result_type max() {
+
+                return ~static_cast<result_type> (0);
+            }
+
+            const result_type operator()() {
+
+                const boost::uint64_t result = rotl(_state[0] + _state[3], 23) + _state[0];
+                const boost::uint64_t tt = _state[1] << 17;
+
+                _state[2] ^= _state[0];
+                _state[3] ^= _state[1];
+                _state[1] ^= _state[2];
+                _state[0] ^= _state[3];
+
+                _state[2] ^= tt;
+                _state[3] = rotl(_state[3], 45);
+
+                return result;
+            }
+
+        };
+    }
+}
+
+#endif	/* XOSHIRO256PP_H */
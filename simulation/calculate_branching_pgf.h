@@ -0,0 +1,195 @@
+#ifndef CALCULATE_BRANCHING_PGF_H
+#define	CALCULATE_BRANCHING_PGF_H
+
+#include <vector> // std::vector
+#include <cmath> // std::expm1
+#include <cassert> // assert
+#include <limits> // std::numeric_limits
+
+#include <mutation_accumulation/parameters/parameters_fwd.h> // Symmetry, etc
+#include <mutation_accumulation/utility/grid.h> // grid::make_uniform_grid
+#include <mutation_accumulation/configuration/configuration/population2D.h> // monte_carlo::Population2D
+#include <mutation_accumulation/configuration/configuration/mutation_rates.h> // monte_carlo::MutationRates
+#include <mutation_accumulation/configuration/configuration/time_grid.h> // monte_carlo::Uniform_Time_Grid
+#include <mutation_accumulation/configuration/configuration/branching_discrete.h> // monte_carlo::Branching_Discrete, branching_discrete::log_no_descendant
+#include <mutation_accumulation/simulation/read_policy.h> // monte_carlo::Read_Homeostasis_Policy
+#include <mutation_accumulation/simulation/files.h> // monte_carlo::done
+#include <mutation_accumulation/simulation/exact_statistics.h> // monte_carlo::exact_statistics::store_mutation_cdfs, etc
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * exact mutation-time distributions of the multitype branching process simulated by Branching_Discrete \n
+     * \n
+     * cells divide independently, so the probability that a type-jj cell has no type-spe descendant after tt generations, \n
+     * q_jj(tt), obeys q_jj(tt + 1) = f_jj(q(tt)), where f_jj is the offspring probability-generating function \n
+     * f_jj(x) = p0 x_jj^2 + p1 x_jj x_(jj+1) + p2 x_jj + p3 x_(jj+1) + p4 (see branching_discrete::categorical_probabilities), \n
+     * q_spe = 0 and q_jj(0) = 1 (see branching_discrete::log_no_descendant); \n
+     * the probability that species spe has not arisen in a sub-population by generation tt is the product of q_jj(tt)^n_jj over its initial cells \n
+     * \n
+     * cost is O(time span * number of species) per species, with no Monte Carlo noise \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    template <class population_type>
+    class Branching_PGF {
+    private:
+
+        Population2D<population_type> _population2D;
+        MutationRates _uu;
+        Symmetry _ss;
+        SymmetricRenewal _rr;
+
+    private:
+
+        /**
+         * log probability that a single cell of each species below spe has no type-spe descendant, after each of 0 ... time_span generations \n
+         * element (tt, jj) of the returned table
+         */
+        const std::vector<std::vector<double> > log_no_descendant(const int &spe, const int &time_span) const {
+
+            return branching_discrete::log_no_descendant(spe, _population2D.number_species(), _uu, _ss, _rr, time_span);
+        }
+
+        /**
+         * log probability that species spe has not arisen in sub-population pop by each generation, given table of log_no_descendant(..) \n
+         * minus infinity if spe is present initially
+         */
+        const std::vector<double> log_not_arisen(const Pop &pop, const Spe &spe, const std::vector<std::vector<double> > &log_qq) const {
+
+            if (_population2D.at(pop.value(), spe.value()) > static_cast<population_type> (0))
+                return std::vector<double>(log_qq.size(), -std::numeric_limits<double>::infinity());
+
+            std::vector<double> log_probabilities(log_qq.size(), 0.0);
+            for (int tt = 0; tt < log_qq.size(); tt++)
+                for (int jj = 0; jj < spe.value(); jj++)
+                    log_probabilities.at(tt) += static_cast<double> (_population2D.at(pop.value(), jj)) * log_qq.at(tt).at(jj);
+
+            return log_probabilities;
+        }
+
+        /**
+         * convert log probability that species has not arisen, by each generation, to probability that it has, by each of times
+         */
+        static const std::vector<double> cdf_from_log_not_arisen(const std::vector<double> &log_probabilities, const std::vector<int> &times) {
+
+            std::vector<double> cdf(times.size());
+            for (int ii = 0; ii < times.size(); ii++)
+                cdf.at(ii) = 0.0 - std::expm1(log_probabilities.at(times.at(ii))); // not -expm1(..), which gives -0
+
+            return cdf;
+        }
+
+    public:
+
+        /**
+         * constructor \n
+         * parameters as for Branching_Discrete
+         */
+        explicit Branching_PGF(
+                const Population2D<population_type> &population2D,
+                const MutationRates &uu,
+                const Symmetry &ss,
+                const SymmetricRenewal &rr)
+        : _population2D(population2D), _uu(uu), _ss(ss), _rr(rr) {
+
+            assert(uu.size() == (population2D.number_species() - 1));
+        }
+
+        /**
+         * probability that species spe has arisen in sub-population pop by each of the generations in times (non-decreasing)
+         */
+        const std::vector<double> cdf(const Pop &pop, const Spe &spe, const std::vector<int> &times) const {
+
+            return cdf_from_log_not_arisen(log_not_arisen(pop, spe, log_no_descendant(spe.value(), times.back())), times);
+        }
+
+        /**
+         * probability that species spe has arisen in any sub-population by each of the generations in times (non-decreasing) \n
+         * sub-populations are independent
+         */
+        const std::vector<double> cdf(const Spe &spe, const std::vector<int> &times) const {
+
+            const std::vector<std::vector<double> > log_qq = log_no_descendant(spe.value(), times.back());
+
+            std::vector<double> log_probabilities(log_qq.size(), 0.0);
+            for (int pop = 0; pop < _population2D.number_sub_pops(); pop++) {
+                const std::vector<double> log_probabilities_pop = log_not_arisen(Pop(pop), spe, log_qq);
+                for (int tt = 0; tt < log_probabilities.size(); tt++)
+                    log_probabilities.at(tt) += log_probabilities_pop.at(tt);
+            }
+
+            return cdf_from_log_not_arisen(log_probabilities, times);
+        }
+
+        const int number_sub_pops() const {
+
+            return _population2D.number_sub_pops();
+        }
+
+        const int number_species() const {
+
+            return _population2D.number_species();
+        }
+
+        /**
+         * probability that the last species arises in any sub-population within time_span generations
+         */
+        const double lifetime_risk(const int &time_span) const {
+
+            return cdf(Spe(_population2D.number_species() - 1), std::vector<int>(1, time_span)).back();
+        }
+
+    };
+
+    /**
+     * calculate mutation-time CDFs and lifetime risk of Branching_Discrete exactly (see Branching_PGF) \n
+     * input file is the one read by Calculate_Histogram_Trajs, and output files are those written by \n
+     * Calculate_Histogram_Trajs (mutation-time CDFs, on the same sample space) and Calculate_Combined_Statistics (lifetime_risk.dat), \n
+     * so that the exact solution can replace, or validate, the stochastic one \n
+     * error probability and observer divisor are read but not used \n
+     * function template not used for uniformity with Calculate_Histogram_Trajs
+     */
+    template <
+    class population_type,
+    template <class Configuration_type> class Read_Policy = Read_Homeostasis_Policy
+    >
+    class Calculate_Branching_PGF {
+    private:
+
+        typedef Branching_Discrete<population_type> Configuration_Policy;
+        typedef typename Configuration_Policy::time_t time_type;
+
+    public:
+
+        static const void implement() {
+
+            /* set up policy object that reads input */
+            Read_Policy<Configuration_Policy> read_policy("main.in");
+
+            {
+                const Population2D<population_type> population2D = read_policy.get_population();
+                const Branching_PGF<population_type> branching_pgf(population2D, read_policy.getUu(), read_policy.getSymmetry(), read_policy.get_SymmetricRenewal());
+
+                /* sample space of Statistics_Mutation */
+                const time_type time_span_histogram = read_policy.getTime_span_histogram();
+                const std::vector<time_type> sample_space = grid::make_uniform_grid(100, static_cast<time_type> (0), time_span_histogram);
+
+                /* mutation-time CDFs tracked by Statistics_Mutation */
+                exact_statistics::store_mutation_cdfs(branching_pgf, sample_space, read_policy.get_statistics_registry());
+
+                /* dump lifetime risk over time span of path to disk */
+                const Uniform_Time_Grid<time_type> time_grid = read_policy.getTime_grid();
+                exact_statistics::store_lifetime_risk(branching_pgf.lifetime_risk(time_grid.at(Node(time_grid.size() - 1))));
+
+            }
+
+            /* indicate that simulation has finished */
+            done();
+        }
+    };
+
+}
+
+#endif	/* CALCULATE_BRANCHING_PGF_H */
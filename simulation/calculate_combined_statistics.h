@@ -0,0 +1,116 @@
+#ifndef CALCULATE_COMBINED_STATISTICS_H
+#define	CALCULATE_COMBINED_STATISTICS_H
+
+#include <iomanip> // std::setw, etc
+
+#include <mutation_accumulation/statistics/statistics/statistics_mutation.h> // monte_carlo::Statistics_Mutation
+#include <mutation_accumulation/statistics/statistics/statistics_extinction.h> // monte_carlo::Statistics_Extinction
+#include <mutation_accumulation/statistics/statistics/statistics_lifetime_risk.h> // monte_carlo::Statistics_Lifetime_Risk
+#include <mutation_accumulation/statistics/statistics/statistics_composite.h> // monte_carlo::Statistics_Composite
+#include <mutation_accumulation/configuration/configuration/path_policy.h> // monte_carlo::Wait_For_Last_Species_In_All_SubPops
+#include <mutation_accumulation/simulation/generate_statistics.h> // monte_carlo::Generate_Statistics
+#include <mutation_accumulation/configuration/utilities/create_configuration.h> // monte_carlo::create_configuration
+#include <mutation_accumulation/simulation/read_policy.h>
+#include <mutation_accumulation/simulation/files.h> // monte_carlo::open_file_for_output
+#include <mutation_accumulation/statistics/utilities/create_statistics.h> // monte_carlo::create_statistics
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * calculate mutation-time CDFs, extinction-time CDFs, and lifetime risk from a single Monte Carlo run\n
+     * input file is the one read by Calculate_Histogram_Trajs \n
+     * \n
+     * mutation-time histograms are written to the same files as Calculate_Histogram_Trajs; \n
+     * extinction-time and lifetime-risk histograms are prefixed by "extinction__" and "lifetime_risk__"; \n
+     * lifetime risk of the whole population is written to lifetime_risk.dat \n
+     * cells selected in the input file (see read_statistics_registry) apply to the mutation-time histograms \n
+     * \n
+     * simulation stops when both the mutation-time CDF and the lifetime risk have converged; \n
+     * the extinction-time CDF is a passenger (extinction need not occur, e.g. in Moran configurations) \n
+     * \n
+     * path policy is that of Calculate_Histogram_Trajs: \n
+     * once the last species has arisen in a sub-population, that sub-population cannot extinguish, \n
+     * so extinction times are complete whenever the path is terminated
+     */
+    template <
+    class Histogram_Policy,
+    class Configuration_Policy,
+    template <class Configuration_type> class Raw_Data_Policy = Raw_Data_Null,
+    template <class Configuration_type> class Read_Policy = Read_Homeostasis_Policy
+    >
+    class Calculate_Combined_Statistics {
+    public:
+
+        static const void implement() {
+
+            /* set up policy object that reads input */
+            Read_Policy<Configuration_Policy> read_policy("main.in");
+
+            {
+                /* initialize configuration */
+                typename Configuration_Policy::category configuration_category;
+                const Configuration_Policy configuration_init = create_configuration<Configuration_Policy > (configuration_category, read_policy);
+
+                /* observe statistics in first sub-population, and in last species */
+                const Number_Pop number_pop(read_policy.get_population().number_sub_pops());
+                const Number_Spe number_spe(read_policy.get_population().number_species());
+                const Pop pop_to_observe(0);
+                const Spe spe_to_observe(number_spe.value() - 1);
+
+                /* create statistics gatherers */
+                typedef Statistics_Mutation<Histogram_Policy, Configuration_Policy> Statistics_Mutation_type;
+                Statistics_Mutation_type statistics_mutation = create_statistics<Statistics_Mutation_type, Configuration_Policy > (read_policy);
+
+                typedef Statistics_Extinction<Histogram_Policy, Configuration_Policy> Statistics_Extinction_type;
+                Statistics_Extinction_type statistics_extinction(
+                        number_pop,
+                        read_policy.getTime_span_histogram(),
+                        read_policy.get_error_prob(),
+                        pop_to_observe,
+                        read_policy.get_observer_divisor(),
+                        "extinction__");
+
+                typedef Statistics_Lifetime_Risk<Configuration_Policy> Statistics_Lifetime_Risk_type;
+                Statistics_Lifetime_Risk_type statistics_lifetime_risk(
+                        number_pop,
+                        number_spe,
+                        read_policy.get_error_prob(),
+                        pop_to_observe,
+                        spe_to_observe,
+                        read_policy.get_observer_divisor(),
+                        "lifetime_risk__");
+
+                /* fan trajectories out to all gatherers */
+                typedef Statistics_Composite<Statistics_Lifetime_Risk_type, Statistics_Extinction_type, Converge_First> Statistics_Passenger_type;
+                Statistics_Passenger_type statistics_passenger(statistics_lifetime_risk, statistics_extinction);
+
+                typedef Statistics_Composite<Statistics_Mutation_type, Statistics_Passenger_type, Converge_All> Statistics_Policy;
+                Statistics_Policy statistics(statistics_mutation, statistics_passenger);
+
+                /* path policy */
+                typedef Wait_For_Last_Species_In_All_SubPops<Configuration_Policy> Path_Policy;
+
+                /* do Monte Carlo simulation once; gather all statistics */
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy, Raw_Data_Policy >::implement(configuration_init, statistics);
+
+                /* dump lifetime risk to disk */
+                boost::shared_ptr<std::ofstream> ofstream_ptr = open_file_for_output("lifetime_risk.dat");
+                *ofstream_ptr << std::setw(30) << std::setprecision(20);
+                *ofstream_ptr << probability_mutation_fate(statistics_lifetime_risk);
+                *ofstream_ptr << std::endl;
+
+            }
+
+            /* indicate that simulation has finished */
+            done();
+        }
+    };
+
+
+}
+
+
+
+#endif	/* CALCULATE_COMBINED_STATISTICS_H */
@@ -0,0 +1,231 @@
+#ifndef CALCULATE_FACTORIZED_STATISTICS_H
+#define	CALCULATE_FACTORIZED_STATISTICS_H
+
+#include <vector> // std::vector
+#include <string> // std::string
+#include <cmath> // std::pow, std::expm1, std::log1p
+#include <iostream> // std::cerr
+#include <cassert> // assert
+
+#include <boost/static_assert.hpp> // BOOST_STATIC_ASSERT
+#include <boost/type_traits/is_same.hpp> // boost::is_same
+#include <boost/lexical_cast.hpp> // boost::lexical_cast
+
+#include <mutation_accumulation/utility/configuration_traits.h> // configuration_categories::branching_category
+#include <mutation_accumulation/statistics/statistics/statistics_mutation.h> // monte_carlo::Statistics_Mutation
+#include <mutation_accumulation/statistics/statistics/statistics_extinction.h> // monte_carlo::Statistics_Extinction
+#include <mutation_accumulation/statistics/statistics/statistics_lifetime_risk.h> // monte_carlo::Statistics_Lifetime_Risk
+#include <mutation_accumulation/statistics/statistics/statistics_composite.h> // monte_carlo::Statistics_Composite
+#include <mutation_accumulation/configuration/configuration/path_policy.h> // monte_carlo::Wait_For_Last_Species_In_All_SubPops
+#include <mutation_accumulation/simulation/generate_statistics.h> // monte_carlo::Generate_Statistics
+#include <mutation_accumulation/configuration/utilities/create_configuration.h> // monte_carlo::create_configuration
+#include <mutation_accumulation/simulation/read_policy.h> // monte_carlo::Read_Sub_Population_Policy
+#include <mutation_accumulation/simulation/raw_data.h> // monte_carlo::Raw_Data_Null
+#include <mutation_accumulation/simulation/files.h> // monte_carlo::done
+#include <mutation_accumulation/simulation/exact_statistics.h> // monte_carlo::exact_statistics::store_cdf, etc
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace calculate_factorized_statistics_detail {
+
+        /**
+         * probability that an event has occurred in at least one of number_sub_pops independent sub-populations, \n
+         * given the probability cdf that it has occurred in one of them
+         */
+        inline const std::vector<double> any_of(const std::vector<double> &cdf, const int &number_sub_pops) {
+
+            std::vector<double> cdf_any(cdf.size());
+            for (std::vector<double>::size_type ii = 0; ii < cdf.size(); ii++)
+                cdf_any.at(ii) = 0.0 - std::expm1(number_sub_pops * std::log1p(-cdf.at(ii))); // 1 - (1 - cdf)^P, accurate when cdf is small
+
+            return cdf_any;
+        }
+
+        /**
+         * probability that an event has occurred in all of number_sub_pops independent sub-populations
+         */
+        inline const std::vector<double> all_of(const std::vector<double> &cdf, const int &number_sub_pops) {
+
+            std::vector<double> cdf_all(cdf.size());
+            for (std::vector<double>::size_type ii = 0; ii < cdf.size(); ii++)
+                cdf_all.at(ii) = std::pow(cdf.at(ii), number_sub_pops);
+
+            return cdf_all;
+        }
+
+        /**
+         * true if every sub-population starts with the populations of the first
+         */
+        template <class population_type>
+        const bool identical_sub_pops(const Population2D<population_type> &population2D) {
+
+            for (int pop = 1; pop < population2D.number_sub_pops(); pop++)
+                for (int spe = 0; spe < population2D.number_species(); spe++)
+                    if (population2D.at(pop, spe) != population2D.at(0, spe)) return false;
+
+            return true;
+        }
+
+    }
+
+    /**
+     * calculate the statistics of Calculate_Combined_Statistics by simulating a single sub-population \n
+     * \n
+     * sub-populations of branching configurations evolve independently; \n
+     * if they start identically, their mutation and extinction times are independent and identically distributed, \n
+     * so that single sub-population trajectories are iid samples of every sub-population, \n
+     * and whole-population distributions follow from those of a single sub-population: \n
+     * P(spe has arisen in the whole population by t) = 1 - (1 - P(spe has arisen in a sub-population by t))^P, \n
+     * P(whole population extinct by t) = P(sub-population extinct by t)^P, \n
+     * for P sub-populations; this cuts the cost of simulation by a factor of about P \n
+     * \n
+     * convergence is judged, at the error probability of the input file, on the single sub-population CDFs; \n
+     * the relative error of 1 - (1 - F)^P is at most that of F, so the whole-population mutation-time CDFs and lifetime risk \n
+     * are as accurate as the sub-population ones; \n
+     * the relative error of F^P is about P times that of F, so the whole-population extinction-time CDF is P times less accurate \n
+     * (extinction is, as in Calculate_Combined_Statistics, observed but not a convergence criterion) \n
+     * \n
+     * input file is the one read by Calculate_Histogram_Trajs; \n
+     * single sub-population histograms are written with the prefix "subpop__"; \n
+     * mutation-time and extinction-time CDFs of each sub-population, and of the whole population, \n
+     * are written to the files of Calculate_Combined_Statistics, as is lifetime_risk.dat \n
+     * cells selected in the input file apply to the mutation-time CDFs \n
+     * function template not used for uniformity with Calculate_Combined_Statistics
+     */
+    template <
+    class Histogram_Policy,
+    class Configuration_Policy,
+    template <class Configuration_type> class Raw_Data_Policy = Raw_Data_Null,
+    template <class Configuration_type> class Read_Policy = Read_Homeostasis_Policy
+    >
+    class Calculate_Factorized_Statistics {
+    private:
+
+        typedef typename Configuration_Policy::population_t population_type; // Item 42
+
+    public:
+
+        static const void implement() {
+
+            /* sub-populations evolve independently only in branching configurations */
+            BOOST_STATIC_ASSERT((boost::is_same<typename Configuration_Policy::category, configuration_categories::branching_category>::value));
+
+            /* set up policy object that reads input */
+            Read_Policy<Configuration_Policy> read_policy("main.in");
+
+            {
+                const Population2D<population_type> population2D = read_policy.get_population();
+                if (!calculate_factorized_statistics_detail::identical_sub_pops(population2D)) {
+                    std::cerr << "factorized statistics require sub-populations that start identically" << std::endl;
+                    assert(false);
+                }
+                const int number_sub_pops = population2D.number_sub_pops();
+
+                /* simulate the first sub-population on its own */
+                const Read_Sub_Population_Policy<Configuration_Policy> read_policy_sub_pop(read_policy, Pop(0));
+
+                /* initialize configuration */
+                typename Configuration_Policy::category configuration_category;
+                const Configuration_Policy configuration_init = create_configuration<Configuration_Policy > (configuration_category, read_policy_sub_pop);
+
+                /* observe statistics in the sub-population, and in last species */
+                const Number_Pop number_pop(1);
+                const Number_Spe number_spe(population2D.number_species());
+                const Pop pop_to_observe(0);
+                const Spe spe_to_observe(number_spe.value() - 1);
+
+                /* create statistics gatherers */
+                typedef Statistics_Mutation<Histogram_Policy, Configuration_Policy> Statistics_Mutation_type;
+                Statistics_Mutation_type statistics_mutation(
+                        number_pop,
+                        number_spe,
+                        read_policy.getTime_span_histogram(),
+                        read_policy.get_error_prob(),
+                        pop_to_observe,
+                        spe_to_observe,
+                        read_policy.get_observer_divisor(),
+                        "subpop__");
+
+                typedef Statistics_Extinction<Histogram_Policy, Configuration_Policy> Statistics_Extinction_type;
+                Statistics_Extinction_type statistics_extinction(
+                        number_pop,
+                        read_policy.getTime_span_histogram(),
+                        read_policy.get_error_prob(),
+                        pop_to_observe,
+                        read_policy.get_observer_divisor(),
+                        "subpop__extinction__");
+
+                typedef Statistics_Lifetime_Risk<Configuration_Policy> Statistics_Lifetime_Risk_type;
+                Statistics_Lifetime_Risk_type statistics_lifetime_risk(
+                        number_pop,
+                        number_spe,
+                        read_policy.get_error_prob(),
+                        pop_to_observe,
+                        spe_to_observe,
+                        read_policy.get_observer_divisor(),
+                        "subpop__lifetime_risk__");
+
+                /* fan trajectories out to all gatherers */
+                typedef Statistics_Composite<Statistics_Lifetime_Risk_type, Statistics_Extinction_type, Converge_First> Statistics_Passenger_type;
+                Statistics_Passenger_type statistics_passenger(statistics_lifetime_risk, statistics_extinction);
+
+                typedef Statistics_Composite<Statistics_Mutation_type, Statistics_Passenger_type, Converge_All> Statistics_Policy;
+                Statistics_Policy statistics(statistics_mutation, statistics_passenger);
+
+                /* path policy */
+                typedef Wait_For_Last_Species_In_All_SubPops<Configuration_Policy> Path_Policy;
+
+                /* do Monte Carlo simulation of the sub-population once; gather all statistics */
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy, Raw_Data_Policy >::implement(configuration_init, statistics);
+
+                /* mutation-time CDFs: every sub-population is distributed as the simulated one */
+                const Statistics_Registry registry = read_policy.get_statistics_registry();
+                for (int spe = 0; spe < number_spe.value(); spe++) {
+
+                    const probability::SampleSpace_Probability<typename Histogram_Policy::sample_t> results =
+                            statistics_mutation.get_results_so_far().at(0, spe, 0);
+
+                    for (int pop = 0; pop < number_sub_pops; pop++) {
+
+                        const bool observed = (pop == pop_to_observe.value()) && (spe == spe_to_observe.value());
+                        if (!(observed || registry.tracked(pop, spe, 0))) continue;
+
+                        const std::string filename = "histogram__pop" + boost::lexical_cast<std::string > (pop) + "__spe" + boost::lexical_cast<std::string > (spe) + "__xxx0.dat";
+                        exact_statistics::store_cdf(filename, results.sample_space(), results.probability());
+                    }
+
+                    if (!registry.tracked_whole(spe, 0)) continue;
+
+                    const std::string filename = "histogramWhole__spe" + boost::lexical_cast<std::string > (spe) + "__xxx0.dat";
+                    exact_statistics::store_cdf(filename, results.sample_space(), calculate_factorized_statistics_detail::any_of(results.probability(), number_sub_pops));
+                }
+
+                /* extinction-time CDFs */
+                {
+                    const probability::SampleSpace_Probability<typename Histogram_Policy::sample_t> results =
+                            statistics_extinction.get_results_so_far().at(0, 0, 0);
+
+                    for (int pop = 0; pop < number_sub_pops; pop++) {
+                        const std::string filename = "extinction__histogram__pop" + boost::lexical_cast<std::string > (pop) + "__xxx0__xxx0.dat";
+                        exact_statistics::store_cdf(filename, results.sample_space(), results.probability());
+                    }
+
+                    exact_statistics::store_cdf("extinction__histogramWhole__xxx0__xxx0.dat", results.sample_space(), calculate_factorized_statistics_detail::all_of(results.probability(), number_sub_pops));
+                }
+
+                /* dump lifetime risk to disk */
+                const std::vector<double> lifetime_risk(1, probability_mutation_fate(statistics_lifetime_risk));
+                exact_statistics::store_lifetime_risk(calculate_factorized_statistics_detail::any_of(lifetime_risk, number_sub_pops).front());
+
+            }
+
+            /* indicate that simulation has finished */
+            done();
+        }
+    };
+
+}
+
+#endif	/* CALCULATE_FACTORIZED_STATISTICS_H */
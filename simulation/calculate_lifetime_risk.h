@@ -4,16 +4,34 @@
 //#define DEBUG_CALCULATE_LIFETIME_RISK_H
 
 #include <cassert> // assert
+#include <algorithm> // std::stable_sort, std::sort, std::max, std::min
+#include <map> // std::map
+#include <utility> // std::pair
+#include <cmath> // std::sqrt, std::fabs, std::floor
+#include <mutex> // std::mutex, std::lock_guard
+#include <typeinfo> // typeid
+#include <limits> // std::numeric_limits
+#include <iostream> // std::cerr
+
+#include <boost/lexical_cast.hpp> // boost::lexical_cast
+#include <boost/type_traits/integral_constant.hpp> // boost::true_type, boost::false_type
 
 #include <mutation_accumulation/utility/strings.h> // strings::parse_scalar, etc
 #include <mutation_accumulation/configuration/configuration/time_grid.h> // monte_carlo::Uniform_Time_Grid
 #include <mutation_accumulation/configuration/configuration/mutation_rates.h> // monte_carlo::MutationRates
 #include <mutation_accumulation/configuration/configuration/population2D.h> // monte_carlo::Population2D
 #include <mutation_accumulation/statistics/statistics/statistics_lifetime_risk.h> // monte_carlo::Statistics_Lifetime_Risk
-#include <mutation_accumulation/configuration/configuration/path_policy.h> // monte_carlo::Wait_For_Last_Species_In_All_SubPops
+#include <mutation_accumulation/statistics/statistics/statistics_lifetime_risk_weighted.h> // monte_carlo::Statistics_Lifetime_Risk_Weighted
+#include <mutation_accumulation/statistics/statistics/statistics_lifetime_sensitivity.h> // monte_carlo::Statistics_Lifetime_Sensitivity
+#include <mutation_accumulation/statistics/statistics/statistics_lifetime_risk_conditional.h> // monte_carlo::Statistics_Lifetime_Risk_Conditional
+#include <mutation_accumulation/statistics/statistics/statistics_composite.h> // monte_carlo::Statistics_Composite
+#include <mutation_accumulation/configuration/configuration/path_policy.h> // monte_carlo::Wait_For_Last_Species_In_All_SubPops, etc
 #include <mutation_accumulation/simulation/generate_statistics.h> // monte_carlo::generate_statistics
 #include <mutation_accumulation/utility/grid.h> // grid::make_logarithmic_grid
-#include <mutation_accumulation/configuration/utilities/create.h> // monte_carlo::create_configuration
+#include <mutation_accumulation/configuration/utilities/create_configuration.h> // monte_carlo::create_configuration
+#include <mutation_accumulation/simulation/sweep_scheduler.h> // monte_carlo::run_sweep
+#include <mutation_accumulation/simulation/result_cache.h> // monte_carlo::Result_Cache
+#include <mutation_accumulation/simulation/multilevel_splitting.h> // monte_carlo::Multilevel_Splitting
 
 
 /*************************************************************************/
@@ -25,26 +43,12 @@ namespace monte_carlo {
         typedef double error_type;
         typedef int divisor_type;
 
-        /** 
-         * calculate lifetime risk for a particular parameter set and a generic homeostatic stochastic process 
-         * assumes that number of species = 1 + (number of mutation rates), which isn't true for "diamond"; diamond configuration will complain at compile time
+        /**
+         * create initial population matrix with a size determined by size of uu: N0 cells of the first species
          */
-        template <class Configuration_Policy>
-        const double calculate_lifetime_risk(
-                const typename Configuration_Policy::population_t &N0,
-                const MutationRates &uu,
-                const Symmetry &symmetry,
-                const typename Configuration_Policy::time_t &time_span_path,
-                const error_type &error_probability,
-                const divisor_type &observer_divisor) {
-
-            typedef typename Configuration_Policy::time_t time_type;
-            typedef typename Configuration_Policy::population_t population_type;
-
-            /* create a uniform grid of time points at which to sample configuration */
-            Uniform_Time_Grid<time_type> time_grid(time_span_path);
+        template <class population_type>
+        const Population2D<population_type> make_initial_population(const population_type &N0, const MutationRates &uu) {
 
-            /* create initial population matrix with a size determined by size of uu */
             const int number_species = uu.size() + 1;
             std::vector<population_type> NN_vec(number_species);
             NN_vec.at(0) = N0;
@@ -66,6 +70,296 @@ namespace monte_carlo {
             assert(uu.get_dim() == (NN.number_species() - 1));
 #endif
 
+            return NN;
+        }
+
+        /**
+         * calculate lifetime risk by importance sampling: paths are simulated with mutation rates multiplied by tilt, \n
+         * and weighted by their likelihood ratios (see Statistics_Lifetime_Risk_Weighted) \n
+         * tilted rates must stay below one half \n
+         * weighted statistics are not cached
+         */
+        template <class Configuration_Policy>
+        const double calculate_lifetime_risk_tilted(
+                const typename Configuration_Policy::population_t &N0,
+                const MutationRates &uu,
+                const Symmetry &symmetry,
+                const Uniform_Time_Grid<typename Configuration_Policy::time_t> &time_grid,
+                const error_type &error_probability,
+                const unsigned int &seed,
+                const bool &coupled,
+                const double &tilt) {
+
+            typedef typename Configuration_Policy::population_t population_type;
+
+            const Population2D<population_type> NN = make_initial_population(N0, uu);
+
+            /* inflate mutation rates */
+            MutationRates uu_sampling(uu.size());
+            for (int ii = 0; ii < uu.size(); ii++)
+                uu_sampling.at(ii) = tilt * uu.at(ii);
+            if (!valid_sampling_rates(uu, uu_sampling)) {
+                std::cerr << "tilt = " << tilt << " gives invalid sampling mutation rates" << std::endl;
+                assert(false);
+            }
+
+            /* initialize configuration */
+            typename Configuration_Policy::category configuration_category;
+            const Configuration_Policy configuration_init = create_configuration<Configuration_Policy > (configuration_category, NN, uu, symmetry, time_grid, uu_sampling);
+
+            /* observe statistics of last species in first sub-population */
+            typedef Statistics_Lifetime_Risk_Weighted<Configuration_Policy> Statistics_Policy;
+            Statistics_Policy statistics(
+                    Number_Pop(NN.number_sub_pops()),
+                    Number_Spe(NN.number_species()),
+                    error_probability,
+                    Pop(0),
+                    Spe(NN.number_species() - 1));
+
+            /* path policy */
+            typedef Wait_For_Last_Species_In_All_SubPops<Configuration_Policy> Path_Policy;
+
+            /* do Monte Carlo simulation; gather statistics */
+            if (coupled)
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy, Raw_Data_Null, Per_Trial_Streams>::implement(configuration_init, statistics, seed);
+            else
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy >::implement(configuration_init, statistics, seed);
+
+            /* calculate lifetime risk and return */
+            return probability_mutation_fate(statistics);
+
+        }
+
+        /**
+         * calculate lifetime risk by fixed-effort multilevel splitting, with splitting_effort trajectories per level \n
+         * (see Multilevel_Splitting); the cumulative distribution of the time at which the last species arises \n
+         * is written to file_prefix + "mutationTime_cdf.dat" (node time, probability) \n
+         * splitting estimates are not cached
+         */
+        template <class Configuration_Policy>
+        const double calculate_lifetime_risk_split(
+                const typename Configuration_Policy::population_t &N0,
+                const MutationRates &uu,
+                const Symmetry &symmetry,
+                const Uniform_Time_Grid<typename Configuration_Policy::time_t> &time_grid,
+                const error_type &error_probability,
+                const std::string &file_prefix,
+                const unsigned int &seed,
+                const int &splitting_effort) {
+
+            typedef typename Configuration_Policy::population_t population_type;
+
+            const Population2D<population_type> NN = make_initial_population(N0, uu);
+
+            /* initialize configuration */
+            typename Configuration_Policy::category configuration_category;
+            const Configuration_Policy configuration_init = create_configuration<Configuration_Policy > (configuration_category, NN, uu, symmetry, time_grid);
+
+            /* split trajectories at the levels at which successive species arise */
+            const Splitting_Estimate estimate = Multilevel_Splitting<Configuration_Policy>::implement(configuration_init, time_grid, splitting_effort, error_probability, seed);
+
+            boost::shared_ptr<std::ofstream> ofstream_ptr = monte_carlo::open_file_for_output(file_prefix + "mutationTime_cdf.dat");
+            for (int node = 0; node < time_grid.size(); node++) {
+                *ofstream_ptr << std::setw(30) << std::setprecision(20) << time_grid.at(Node(node));
+                *ofstream_ptr << std::setw(30) << std::setprecision(20) << estimate.cdf(Node(node));
+                *ofstream_ptr << std::endl;
+            }
+
+            return estimate.lifetime_risk();
+
+        }
+
+        /**
+         * calculate lifetime risk by conditional Monte Carlo: trajectories stop once the penultimate species has arisen in every sub-population, \n
+         * and the last mutation step is integrated out (see Statistics_Lifetime_Risk_Conditional); \n
+         * the configuration must be able to calculate the probability that the last species arises in the rest of the time span \n
+         * conditional statistics are not cached
+         */
+        template <class Configuration_Policy>
+        const double calculate_lifetime_risk_conditional(
+                const typename Configuration_Policy::population_t &N0,
+                const MutationRates &uu,
+                const Symmetry &symmetry,
+                const Uniform_Time_Grid<typename Configuration_Policy::time_t> &time_grid,
+                const error_type &error_probability,
+                const unsigned int &seed,
+                const bool &coupled,
+                boost::true_type) {
+
+            typedef typename Configuration_Policy::population_t population_type;
+
+            const Population2D<population_type> NN = make_initial_population(N0, uu);
+
+            /* initialize configuration */
+            typename Configuration_Policy::category configuration_category;
+            const Configuration_Policy configuration_init = create_configuration<Configuration_Policy > (configuration_category, NN, uu, symmetry, time_grid);
+
+            /* observe statistics in first sub-population */
+            typedef Statistics_Lifetime_Risk_Conditional<Configuration_Policy> Statistics_Policy;
+            Statistics_Policy statistics(Number_Pop(NN.number_sub_pops()), error_probability, Pop(0));
+
+            /* path policy */
+            typedef Wait_For_Penultimate_Species_In_All_SubPops<Configuration_Policy> Path_Policy;
+
+            /* do Monte Carlo simulation; gather statistics */
+            if (coupled)
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy, Raw_Data_Null, Per_Trial_Streams>::implement(configuration_init, statistics, seed);
+            else
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy >::implement(configuration_init, statistics, seed);
+
+            /* calculate lifetime risk and return */
+            return probability_mutation_fate(statistics);
+
+        }
+
+        /**
+         * configurations that cannot integrate out the last mutation step (see integrates_last_mutation) \n
+         * are instantiated by drivers that choose conditional Monte Carlo at run time, so they are rejected at run time
+         */
+        template <class Configuration_Policy>
+        const double calculate_lifetime_risk_conditional(
+                const typename Configuration_Policy::population_t &,
+                const MutationRates &,
+                const Symmetry &,
+                const Uniform_Time_Grid<typename Configuration_Policy::time_t> &,
+                const error_type &,
+                const unsigned int &,
+                const bool &,
+                boost::false_type) {
+
+            std::cerr << "conditional Monte Carlo requires a configuration that can integrate out the last mutation step, e.g. Branching_Discrete" << std::endl;
+            assert(false);
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        /**
+         * calculate lifetime risk, together with its derivatives with respect to each mutation rate and symmetry, from the same trials \n
+         * (see Statistics_Lifetime_Sensitivity); the configuration must be able to accumulate a score (see track_score()) \n
+         * derivatives are written to file_prefix + "lifetime_sensitivity.dat" (parameter, derivative, standard error) \n
+         * trials stop when the lifetime risk has converged; sensitivities are not cached
+         */
+        template <class Configuration_Policy>
+        const double calculate_lifetime_risk_sensitivities(
+                const typename Configuration_Policy::population_t &N0,
+                const MutationRates &uu,
+                const Symmetry &symmetry,
+                const Uniform_Time_Grid<typename Configuration_Policy::time_t> &time_grid,
+                const error_type &error_probability,
+                const divisor_type &observer_divisor,
+                const std::string &file_prefix,
+                const unsigned int &seed,
+                const bool &coupled) {
+
+            typedef typename Configuration_Policy::population_t population_type;
+
+            const Population2D<population_type> NN = make_initial_population(N0, uu);
+
+            /* initialize configuration, which passes on score accumulation to its copies */
+            typename Configuration_Policy::category configuration_category;
+            Configuration_Policy configuration_init = create_configuration<Configuration_Policy > (configuration_category, NN, uu, symmetry, time_grid);
+            configuration_init.track_score();
+
+            /* lifetime risk decides when to stop; sensitivities are passengers */
+            typedef Statistics_Lifetime_Risk<Configuration_Policy> Risk_Statistics;
+            Risk_Statistics risk_statistics(
+                    Number_Pop(NN.number_sub_pops()),
+                    Number_Spe(NN.number_species()),
+                    error_probability,
+                    Pop(0),
+                    Spe(NN.number_species() - 1),
+                    observer_divisor,
+                    file_prefix);
+            typedef Statistics_Lifetime_Sensitivity<Configuration_Policy> Sensitivity_Statistics;
+            Sensitivity_Statistics sensitivity_statistics(Number_Pop(NN.number_sub_pops()), Number_Spe(NN.number_species()));
+            typedef Statistics_Composite<Risk_Statistics, Sensitivity_Statistics, Converge_First> Statistics_Policy;
+            Statistics_Policy statistics(risk_statistics, sensitivity_statistics);
+
+            /* path policy */
+            typedef Wait_For_Last_Species_In_All_SubPops<Configuration_Policy> Path_Policy;
+
+            /* do Monte Carlo simulation; gather statistics */
+            if (coupled)
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy, Raw_Data_Null, Per_Trial_Streams>::implement(configuration_init, statistics, seed);
+            else
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy >::implement(configuration_init, statistics, seed);
+
+            /* dump derivatives with respect to mutation rates u0, u1, ..., and symmetry ss */
+            const array::Array2D<double> sensitivities = sensitivity_statistics.get_results_so_far_whole();
+            const array::Array2D<double> standard_errors = sensitivity_statistics.get_standard_errors_so_far_whole();
+            boost::shared_ptr<std::ofstream> ofstream_ptr = monte_carlo::open_file_for_output(file_prefix + "lifetime_sensitivity.dat");
+            for (int parameter = 0; parameter < sensitivities.get_dim0(); parameter++) {
+                const std::string parameter_name = (parameter < uu.size()) ? "u" + boost::lexical_cast<std::string > (parameter) : "ss";
+                *ofstream_ptr << std::setw(30) << parameter_name;
+                *ofstream_ptr << std::setw(30) << std::setprecision(20) << sensitivities.at(parameter, 0);
+                *ofstream_ptr << std::setw(30) << std::setprecision(20) << standard_errors.at(parameter, 0);
+                *ofstream_ptr << std::endl;
+            }
+
+            /* calculate lifetime risk and return */
+            return probability_mutation_fate(risk_statistics);
+
+        }
+
+        /** 
+         * calculate lifetime risk for a particular parameter set and a generic homeostatic stochastic process \n
+         * if coupled, trial k is driven by a random stream that depends only on (seed, k), \n
+         * so runs with equal seeds but different parameters share random numbers trial by trial (see Per_Trial_Streams) \n
+         * statistics cached by earlier runs with the same parameters are reused, and topped up if error_probability is tighter \n
+         * a tilt other than one estimates the risk by importance sampling (see calculate_lifetime_risk_tilted), \n
+         * and a positive splitting effort by multilevel splitting (see calculate_lifetime_risk_split); the two are exclusive \n
+         * if sensitivities are requested, derivatives of the risk are estimated from the same trials (see calculate_lifetime_risk_sensitivities), \n
+         * without tilting, splitting or caching \n
+         * if conditional, the last mutation step is integrated out (see calculate_lifetime_risk_conditional), without tilting, splitting, sensitivities or caching \n
+         * assumes that number of species = 1 + (number of mutation rates), which isn't true for "diamond"; diamond configuration will complain at compile time
+         */
+        template <class Configuration_Policy>
+        const double calculate_lifetime_risk(
+                const typename Configuration_Policy::population_t &N0,
+                const MutationRates &uu,
+                const Symmetry &symmetry,
+                const Uniform_Time_Grid<typename Configuration_Policy::time_t> &time_grid,
+                const error_type &error_probability,
+                const divisor_type &observer_divisor,
+                const std::string &file_prefix,
+                const unsigned int &seed,
+                const bool &coupled = false,
+                const Result_Cache &cache = Result_Cache(),
+                const double &tilt = 1.0,
+                const int &splitting_effort = 0,
+                const bool &sensitivities = false,
+                const bool &conditional = false) {
+
+            typedef typename Configuration_Policy::population_t population_type;
+
+            if (tilt != 1.0 && splitting_effort > 0) {
+                std::cerr << "cannot tilt mutation rates and split trajectories at the same time" << std::endl;
+                assert(false);
+            }
+
+            if (sensitivities && (tilt != 1.0 || splitting_effort > 0)) {
+                std::cerr << "sensitivities are estimated without tilting mutation rates or splitting trajectories" << std::endl;
+                assert(false);
+            }
+
+            if (conditional && (tilt != 1.0 || splitting_effort > 0 || sensitivities)) {
+                std::cerr << "conditional Monte Carlo is used without tilting mutation rates, splitting trajectories or estimating sensitivities" << std::endl;
+                assert(false);
+            }
+
+            if (conditional)
+                return calculate_lifetime_risk_conditional<Configuration_Policy > (N0, uu, symmetry, time_grid, error_probability, seed, coupled, integrates_last_mutation<Configuration_Policy>());
+
+            if (sensitivities)
+                return calculate_lifetime_risk_sensitivities<Configuration_Policy > (N0, uu, symmetry, time_grid, error_probability, observer_divisor, file_prefix, seed, coupled);
+
+            if (splitting_effort > 0)
+                return calculate_lifetime_risk_split<Configuration_Policy > (N0, uu, symmetry, time_grid, error_probability, file_prefix, seed, splitting_effort);
+
+            if (tilt != 1.0)
+                return calculate_lifetime_risk_tilted<Configuration_Policy > (N0, uu, symmetry, time_grid, error_probability, seed, coupled, tilt);
+
+            const Population2D<population_type> NN = make_initial_population(N0, uu);
+
             /* initialize configuration */
             typename Configuration_Policy::category configuration_category;
             const Configuration_Policy configuration_init = create_configuration<Configuration_Policy > (configuration_category, NN, uu, symmetry, time_grid);
@@ -88,13 +382,33 @@ namespace monte_carlo {
                     error_probability,
                     pop_to_observe,
                     spe_to_observe,
-                    observer_divisor);
+                    observer_divisor,
+                    file_prefix);
+
+            /* start from statistics of earlier runs with the same model and parameters */
+            Cache_Key key;
+            key.add("model", typeid (Configuration_Policy).name());
+            key.add("statistics", "lifetime_risk");
+            key.add("N0", N0);
+            std::vector<MutationRates::data_t> uu_values(uu.size());
+            for (int ii = 0; ii < uu.size(); ii++)
+                uu_values.at(ii) = uu.at(ii);
+            key.add("uu", uu_values);
+            key.add("ss", symmetry.value());
+            key.add("time_span", time_grid.at(Node(time_grid.size() - 1)));
+            const long long int number_cached_trials = cache.load(key, statistics);
 
             /* path policy */
             typedef Wait_For_Last_Species_In_All_SubPops<Configuration_Policy> Path_Policy;
 
-            /* do Monte Carlo simulation; gather statistics; find successful paths */
-            Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy >::implement(configuration_init, statistics);
+            /* do Monte Carlo simulation; gather statistics; find successful paths \n
+             * no trials are performed if cached statistics have already converged */
+            if (coupled)
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy, Raw_Data_Null, Per_Trial_Streams>::implement(configuration_init, statistics, seed, number_cached_trials);
+            else
+                Generate_Statistics<Path_Policy, Configuration_Policy, Statistics_Policy >::implement(configuration_init, statistics, seed, number_cached_trials);
+
+            cache.save(key, statistics);
 
             /* calculate lifetime risk and return */
             return probability_mutation_fate(statistics);
@@ -102,7 +416,227 @@ namespace monte_carlo {
         }
 
         /** 
-         * loop over population sizes (and symmetry values) and print out lifetime risk using generic homeostatic stochastic process
+         * calculate lifetime risk for a particular parameter set, seeding the generator with the current time \n
+         * statistics may be cached, mutation rates tilted, trajectories split, sensitivities estimated, and the last mutation step integrated out, \n
+         * as for the overload above
+         */
+        template <class Configuration_Policy>
+        const double calculate_lifetime_risk(
+                const typename Configuration_Policy::population_t &N0,
+                const MutationRates &uu,
+                const Symmetry &symmetry,
+                const typename Configuration_Policy::time_t &time_span_path,
+                const error_type &error_probability,
+                const divisor_type &observer_divisor,
+                const Result_Cache &cache = Result_Cache(),
+                const double &tilt = 1.0,
+                const int &splitting_effort = 0,
+                const bool &sensitivities = false,
+                const bool &conditional = false) {
+
+            /* create a uniform grid of time points at which to sample configuration */
+            const Uniform_Time_Grid<typename Configuration_Policy::time_t> time_grid(time_span_path);
+
+            return calculate_lifetime_risk<Configuration_Policy > (N0, uu, symmetry, time_grid, error_probability, observer_divisor, "", static_cast<unsigned int> (std::time(0)), false, cache, tilt, splitting_effort, sensitivities, conditional);
+
+        }
+
+        /**
+         * a point of the (symmetry x N) grid swept by calculate_lifetime_risk__loop_over_N \n
+         * N_index numbers population sizes in the order in which they are added to the grid
+         */
+        template <class population_type>
+        struct Sweep_Point {
+            int symmetry_index;
+            int N_index;
+            population_type N0;
+        };
+
+        /**
+         * lifetime risk as a function of population size, for each symmetry value
+         */
+        template <class population_type>
+        struct Lifetime_Risk_Curves {
+            typedef std::vector<std::map<population_type, double> > type;
+        };
+
+        /**
+         * population sizes at which to refine a sweep: at most number_refinements geometric midpoints of neighbouring population sizes \n
+         * intervals are ranked by the largest change in lifetime risk across them (over all symmetry values), \n
+         * so that points are added where the curves are steep; \n
+         * intervals across which no curve changes by more than error_probability are flat to within noise, \n
+         * and intervals that contain no intermediate population size cannot be refined, so neither is selected
+         */
+        template <class population_type>
+        const std::vector<population_type> select_refinements(
+                const typename Lifetime_Risk_Curves<population_type>::type &lifetime_risks,
+                const error_type &error_probability,
+                const int &number_refinements) {
+
+            typedef typename std::map<population_type, double>::const_iterator iterator_type;
+
+            std::vector<std::pair<double, population_type> > candidates; // (change in risk, midpoint)
+
+            const std::map<population_type, double> &first_curve = lifetime_risks.at(0);
+            iterator_type lower = first_curve.begin();
+            if (lower == first_curve.end()) return std::vector<population_type > ();
+            for (iterator_type upper = ++iterator_type(lower); upper != first_curve.end(); lower = upper++) {
+
+                const population_type N_lower = lower->first;
+                const population_type N_upper = upper->first;
+                const population_type N_mid = static_cast<population_type> (std::floor(std::sqrt(static_cast<double> (N_lower) * static_cast<double> (N_upper)) + 0.5));
+                if ((N_mid <= N_lower) || (N_mid >= N_upper)) continue;
+
+                double change = 0.0;
+                for (typename Lifetime_Risk_Curves<population_type>::type::size_type ii = 0; ii < lifetime_risks.size(); ii++)
+                    change = std::max(change, std::fabs(lifetime_risks.at(ii).find(N_upper)->second - lifetime_risks.at(ii).find(N_lower)->second));
+                if (change <= error_probability) continue;
+
+                candidates.push_back(std::make_pair(change, N_mid));
+            }
+
+            /* steepest intervals first */
+            std::sort(candidates.begin(), candidates.end());
+            std::reverse(candidates.begin(), candidates.end());
+
+            std::vector<population_type> refinements;
+            for (int ii = 0; ii < std::min(number_refinements, static_cast<int> (candidates.size())); ii++)
+                refinements.push_back(candidates.at(ii).second);
+
+            return refinements;
+        }
+
+        /**
+         * cost of a grid point grows with population size, so larger populations are scheduled first
+         */
+        template <class population_type>
+        const bool more_expensive(const Sweep_Point<population_type> &point1, const Sweep_Point<population_type> &point2) {
+
+            return point1.N0 > point2.N0;
+        }
+
+        /**
+         * grid points for population sizes N_values and every symmetry value, most expensive first \n
+         * population sizes are numbered from first_N_index
+         */
+        template <class population_type>
+        const std::vector<Sweep_Point<population_type> > list_sweep_points(
+                const std::vector<population_type> &N_values,
+                const int &first_N_index,
+                const int &number_symmetry_values) {
+
+            std::vector<Sweep_Point<population_type> > points;
+            for (int ii = 0; ii < number_symmetry_values; ii++)
+                for (typename std::vector<population_type>::size_type jj = 0; jj < N_values.size(); jj++) {
+                    Sweep_Point<population_type> point = {ii, first_N_index + static_cast<int> (jj), N_values.at(jj)};
+                    points.push_back(point);
+                }
+            std::stable_sort(points.begin(), points.end(), more_expensive<population_type>);
+
+            return points;
+        }
+
+        /**
+         * calculates the lifetime risk at a grid point and writes it to the file of its symmetry value as soon as it is known \n
+         * called concurrently by the workers of run_sweep
+         */
+        template <class Configuration_Policy>
+        class Lifetime_Risk_Sweep_Work {
+        private:
+
+            typedef typename Configuration_Policy::time_t time_type;
+            typedef typename Configuration_Policy::population_t population_type;
+
+        private:
+
+            const MutationRates &_uu;
+            const std::vector<Symmetry> &_symmetry_values;
+            const std::vector<std::string> &_symmetry_strings;
+            const Uniform_Time_Grid<time_type> &_time_grid;
+            const error_type _error_probability;
+            const divisor_type _observer_divisor;
+            const unsigned int _seed;
+            const bool _coupled;
+            const Result_Cache _cache;
+            const double _tilt;
+            const int _splitting_effort;
+            const bool _sensitivities;
+            const bool _conditional;
+
+            std::vector<boost::shared_ptr<std::ofstream> > &_ofstream_ptrs; // one file per symmetry value
+            typename Lifetime_Risk_Curves<population_type>::type &_lifetime_risks; // (symmetry, N) 
+            std::mutex _mutex; // guards files and results
+
+        public:
+
+            explicit Lifetime_Risk_Sweep_Work(
+                    const MutationRates &uu,
+                    const std::vector<Symmetry> &symmetry_values,
+                    const std::vector<std::string> &symmetry_strings,
+                    const Uniform_Time_Grid<time_type> &time_grid,
+                    const error_type &error_probability,
+                    const divisor_type &observer_divisor,
+                    const unsigned int &seed,
+                    const bool &coupled,
+                    const Result_Cache &cache,
+                    const double &tilt,
+                    const int &splitting_effort,
+                    const bool &sensitivities,
+                    const bool &conditional,
+                    std::vector<boost::shared_ptr<std::ofstream> > &ofstream_ptrs,
+                    typename Lifetime_Risk_Curves<population_type>::type &lifetime_risks)
+            :
+            _uu(uu),
+            _symmetry_values(symmetry_values),
+            _symmetry_strings(symmetry_strings),
+            _time_grid(time_grid),
+            _error_probability(error_probability),
+            _observer_divisor(observer_divisor),
+            _seed(seed),
+            _coupled(coupled),
+            _cache(cache),
+            _tilt(tilt),
+            _splitting_effort(splitting_effort),
+            _sensitivities(sensitivities),
+            _conditional(conditional),
+            _ofstream_ptrs(ofstream_ptrs),
+            _lifetime_risks(lifetime_risks) {
+
+            }
+
+            void operator()(const Sweep_Point<population_type> &point) {
+
+                /* histogram files of concurrent grid points must not collide */
+                const std::string file_prefix = "s" + _symmetry_strings.at(point.symmetry_index) + "__N" + boost::lexical_cast<std::string > (point.N0) + "__";
+
+                /* independent runs started at the same time must not share a seed; \n
+                 * coupled runs share a seed so that trial k of every grid point uses the same random stream */
+                const unsigned int seed = _coupled ? _seed : _seed + static_cast<unsigned int> (point.N_index * _symmetry_values.size() + point.symmetry_index);
+
+                const double lifetime_risk = calculate_lifetime_risk<Configuration_Policy > (point.N0, _uu, _symmetry_values.at(point.symmetry_index), _time_grid, _error_probability, _observer_divisor, file_prefix, seed, _coupled, _cache, _tilt, _splitting_effort, _sensitivities, _conditional);
+
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                _lifetime_risks.at(point.symmetry_index)[point.N0] = lifetime_risk;
+
+                std::ofstream &ofs = *_ofstream_ptrs.at(point.symmetry_index);
+                ofs << std::setw(30) << std::setprecision(20) << point.N0;
+                ofs << std::setw(30) << std::setprecision(20) << lifetime_risk;
+                ofs << std::endl; // flushes, so finished rows survive an interrupted sweep
+            }
+
+        };
+
+        /** 
+         * loop over population sizes (and symmetry values) and print out lifetime risk using generic homeostatic stochastic process\n
+         * grid points run concurrently (see run_sweep), largest population first, with at most one thread per grid point; \n
+         * optional trailing lines of the input file cap the number of threads, couple the grid points, \n
+         * name a directory that caches statistics across runs, tilt mutation rates, split trajectories, estimate sensitivities, \n
+         * and integrate out the last mutation step (see read_sweep_options); \n
+         * coupled grid points share random numbers trial by trial, which correlates their estimates and so reduces the noise \n
+         * in differences and ratios of lifetime risks (e.g. between symmetry values) \n
+         * after the logarithmic grid, up to a given number of population sizes may be added where the curves are steepest (see select_refinements) \n
+         * histograms of each grid point are prefixed by its symmetry string and population size
          */
         template <class Configuration_Policy>
         const void calculate_lifetime_risk__loop_over_N() {
@@ -158,6 +692,9 @@ namespace monte_carlo {
             /* write log data every observer_divisor times observer is notified */
             const divisor_type observer_divisor = strings::parse_scalar<divisor_type > (*ifstream_ptr);
 
+            /* optionally cap number of threads, couple grid points, cache statistics, and refine N grid */
+            const Sweep_Options sweep_options = read_sweep_options(*ifstream_ptr);
+
             {
                 /* create file to store symmetry strings for matlab use */
                 boost::shared_ptr<std::ofstream> ofstream_ptr_ssFile = monte_carlo::open_file_for_output("ss.in");
@@ -165,19 +702,51 @@ namespace monte_carlo {
                 /* create list of logarithmically spaced population sizes */
                 const std::vector<population_type> N_grid = grid::make_logarithmic_grid(number_N, N_lower, N_upper);
 
-                for (int ii = 0; ii < symmetry_values.size(); ii++) {
+                /* create a uniform grid of time points at which to sample configuration, shared by all grid points */
+                const Uniform_Time_Grid<time_type> time_grid(time_span_path);
+
+                /* create files to store lifetime risks for various N */
+                std::vector<boost::shared_ptr<std::ofstream> > ofstream_ptrs;
+                for (std::vector<Symmetry>::size_type ii = 0; ii < symmetry_values.size(); ii++) {
 
                     /* record symmetry string */
                     *ofstream_ptr_ssFile << symmetry_strings.at(ii) << std::endl;
 
-                    /* create file to store lifetime risks for various N */
                     const std::string filename = "lifetime_risk__s" + symmetry_strings.at(ii) + ".dat";
+                    ofstream_ptrs.push_back(monte_carlo::open_file_for_output(filename));
+                }
+
+                /* calculate lifetime risks concurrently; rows are written in order of completion */
+                typename Lifetime_Risk_Curves<population_type>::type lifetime_risks(symmetry_values.size());
+                Lifetime_Risk_Sweep_Work<Configuration_Policy> work(uu, symmetry_values, symmetry_strings, time_grid, error_probability, observer_divisor, static_cast<unsigned int> (std::time(0)), sweep_options.coupled(), sweep_options.cache(), sweep_options.tilt(), sweep_options.splitting_effort(), sweep_options.sensitivities(), sweep_options.conditional(), ofstream_ptrs, lifetime_risks);
+                run_sweep(list_sweep_points(N_grid, 0, symmetry_values.size()), sweep_options.thread_budget(), work);
+
+                /* refine the grid where lifetime risk changes fastest, in rounds that keep the workers busy */
+                int number_N_added = 0;
+                while (number_N_added < sweep_options.refinements()) {
+
+                    const int number_left = sweep_options.refinements() - number_N_added;
+                    const int number_per_round = std::min(number_left, std::max(1, sweep_options.thread_budget().number_workers(number_left * symmetry_values.size()) / static_cast<int> (symmetry_values.size())));
+
+                    const std::vector<population_type> N_refinements = select_refinements<population_type > (lifetime_risks, error_probability, number_per_round);
+                    if (N_refinements.empty()) break; // curves are resolved
+
+                    run_sweep(list_sweep_points(N_refinements, N_grid.size() + number_N_added, symmetry_values.size()), sweep_options.thread_budget(), work);
+                    number_N_added += N_refinements.size();
+                }
+
+                /* rewrite each file in order of increasing N */
+                for (std::vector<Symmetry>::size_type ii = 0; ii < symmetry_values.size(); ii++) {
+
+                    const std::string filename = "lifetime_risk__s" + symmetry_strings.at(ii) + ".dat";
+                    ofstream_ptrs.at(ii).reset();
                     boost::shared_ptr<std::ofstream> ofstream_ptr = monte_carlo::open_file_for_output(filename);
 
-                    for (int jj = 0; jj < N_grid.size(); jj++) {
+                    typedef typename std::map<population_type, double>::const_iterator iterator_type;
+                    for (iterator_type it = lifetime_risks.at(ii).begin(); it != lifetime_risks.at(ii).end(); ++it) {
 
-                        *ofstream_ptr << std::setw(30) << std::setprecision(20) << N_grid.at(jj);
-                        *ofstream_ptr << std::setw(30) << std::setprecision(20) << calculate_lifetime_risk<Configuration_Policy > (N_grid.at(jj), uu, symmetry_values.at(ii), time_span_path, error_probability, observer_divisor);
+                        *ofstream_ptr << std::setw(30) << std::setprecision(20) << it->first;
+                        *ofstream_ptr << std::setw(30) << std::setprecision(20) << it->second;
                         *ofstream_ptr << std::endl;
                     }
                 }
@@ -223,12 +792,16 @@ namespace monte_carlo {
             /* write log data every observer_divisor times observer is notified */
             const divisor_type observer_divisor = strings::parse_scalar<divisor_type > (*ifstream_ptr);
 
+            /* optionally name a directory that caches statistics across runs, tilt mutation rates, split trajectories, estimate sensitivities, \n
+             * or integrate out the last mutation step (see read_sweep_options); options that only apply to sweeps are rejected */
+            const Sweep_Options options = read_sweep_options(*ifstream_ptr, false);
+
             {
 
                 /* calculate and dump lifetime risk to disk */
                 boost::shared_ptr<std::ofstream> ofstream_ptr = monte_carlo::open_file_for_output("lifetime_risk.dat");
                 *ofstream_ptr << std::setw(30) << std::setprecision(20);
-                *ofstream_ptr << calculate_lifetime_risk<Configuration_Policy > (NN.at(0, 0), uu, symmetry, time_span, error_probability, observer_divisor);
+                *ofstream_ptr << calculate_lifetime_risk<Configuration_Policy > (NN.at(0, 0), uu, symmetry, time_span, error_probability, observer_divisor, options.cache(), options.tilt(), options.splitting_effort(), options.sensitivities(), options.conditional());
                 *ofstream_ptr << std::endl;
 
                 /* indicate that simulation has finished */
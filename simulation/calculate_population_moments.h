@@ -0,0 +1,444 @@
+#ifndef CALCULATE_POPULATION_MOMENTS_H
+#define	CALCULATE_POPULATION_MOMENTS_H
+
+#include <vector> // std::vector
+#include <string> // std::string
+#include <cmath> // std::ceil
+#include <iomanip> // std::setw, etc
+#include <cassert> // assert
+
+#include <boost/lexical_cast.hpp> // boost::lexical_cast
+
+#include <mutation_accumulation/parameters/parameters_fwd.h> // Symmetry, etc
+#include <mutation_accumulation/array/array2D.h> // array::Array2D
+#include <mutation_accumulation/array/array3D.h> // array::Array3D
+#include <mutation_accumulation/array/array4D.h> // array::Array4D
+#include <mutation_accumulation/utility/configuration_traits.h> // configuration_categories::branching_category, etc
+#include <mutation_accumulation/configuration/configuration/population2D.h> // monte_carlo::Population2D
+#include <mutation_accumulation/configuration/configuration/mutation_rates.h> // monte_carlo::MutationRates
+#include <mutation_accumulation/configuration/configuration/time_grid.h> // monte_carlo::Uniform_Time_Grid
+#include <mutation_accumulation/configuration/configuration/branching_discrete.h> // branching_discrete::categorical_probabilities
+#include <mutation_accumulation/configuration/configuration/moran5.h> // moran5::transition_rates
+#include <mutation_accumulation/simulation/read_policy.h> // monte_carlo::Read_Homeostasis_Policy
+#include <mutation_accumulation/simulation/files.h> // monte_carlo::open_file_for_output, monte_carlo::done
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * exact mean and variance of population sizes of the branching process simulated by Branching_Discrete \n
+     * \n
+     * cells divide independently, so the mean populations m of a sub-population obey m(t + 1) = m(t) M, \n
+     * where M(j, k) is the mean number of type-k offspring of a type-j cell, \n
+     * and their covariance matrix obeys C(t + 1) = M^T C(t) M + sum_j m_j(t) V_j, \n
+     * where V_j is the covariance matrix of the offspring of a type-j cell \n
+     * (see branching_discrete::categorical_probabilities for the offspring of each reaction category) \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    template <class population_type>
+    class Branching_Moments {
+    private:
+
+        typedef int time_type;
+
+        enum {
+            number_rxn_categories = 5 // the enum hack (Item 2)
+        };
+
+    private:
+
+        Population2D<population_type> _population2D;
+        array::Array2D<double> _MM; // mean offspring matrix
+        std::vector<array::Array2D<double> > _VV; // offspring covariance matrix of each species
+
+    private:
+
+        /**
+         * number of type-spe offspring of a type-jj cell whose division lies in reaction category cat
+         */
+        static const double offspring(const int &jj, const int &cat, const int &spe) {
+
+            const double offspring_self[] = {2.0, 1.0, 1.0, 0.0, 0.0};
+            const double offspring_mutant[] = {0.0, 1.0, 0.0, 1.0, 0.0};
+
+            if (spe == jj) return offspring_self[cat];
+            if (spe == jj + 1) return offspring_mutant[cat];
+            return 0.0;
+        }
+
+        /**
+         * mean offspring matrix, and offspring covariance matrices, of each species \n
+         * static function removes danger of accidentally referring to the nascent object's as-yet-uninitialized data members (item 9)
+         */
+        static void offspring_moments(
+                const int &number_species,
+                const MutationRates &uu,
+                const Symmetry &ss,
+                const SymmetricRenewal &rr,
+                array::Array2D<double> &MM,
+                std::vector<array::Array2D<double> > &VV) {
+
+            MM = array::Array2D<double>(number_species, number_species, 0.0);
+            VV.clear();
+
+            for (int jj = 0; jj < number_species; jj++) {
+
+                const std::vector<double> probabilities = branching_discrete::categorical_probabilities(jj, number_species, uu, ss, rr);
+
+                for (int spe = 0; spe < number_species; spe++)
+                    for (int cat = 0; cat < number_rxn_categories; cat++)
+                        MM.at(jj, spe) += probabilities.at(cat) * offspring(jj, cat, spe);
+
+                array::Array2D<double> VV_jj(number_species, number_species, 0.0);
+                for (int spe1 = 0; spe1 < number_species; spe1++)
+                    for (int spe2 = 0; spe2 < number_species; spe2++) {
+                        for (int cat = 0; cat < number_rxn_categories; cat++)
+                            VV_jj.at(spe1, spe2) += probabilities.at(cat) * offspring(jj, cat, spe1) * offspring(jj, cat, spe2);
+                        VV_jj.at(spe1, spe2) -= MM.at(jj, spe1) * MM.at(jj, spe2);
+                    }
+                VV.push_back(VV_jj);
+            }
+        }
+
+        const int number_species() const {
+
+            return _population2D.number_species();
+        }
+
+        /**
+         * advance mean and covariance of a sub-population by one generation
+         */
+        void advance(std::vector<double> &mm, array::Array2D<double> &CC) const {
+
+            std::vector<double> mm_next(number_species(), 0.0);
+            for (int jj = 0; jj < number_species(); jj++)
+                for (int spe = 0; spe < number_species(); spe++)
+                    mm_next.at(spe) += mm.at(jj) * _MM.at(jj, spe);
+
+            /* C M */
+            array::Array2D<double> CM(number_species(), number_species(), 0.0);
+            for (int ii = 0; ii < number_species(); ii++)
+                for (int jj = 0; jj < number_species(); jj++)
+                    for (int kk = 0; kk < number_species(); kk++)
+                        CM.at(ii, kk) += CC.at(ii, jj) * _MM.at(jj, kk);
+
+            /* M^T C M + sum_j m_j V_j */
+            array::Array2D<double> CC_next(number_species(), number_species(), 0.0);
+            for (int ii = 0; ii < number_species(); ii++)
+                for (int kk = 0; kk < number_species(); kk++) {
+                    for (int jj = 0; jj < number_species(); jj++)
+                        CC_next.at(ii, kk) += _MM.at(jj, ii) * CM.at(jj, kk) + mm.at(jj) * _VV.at(jj).at(ii, kk);
+                }
+
+            mm.swap(mm_next);
+            CC = CC_next;
+        }
+
+    public:
+
+        /**
+         * constructor \n
+         * parameters as for Branching_Discrete
+         */
+        explicit Branching_Moments(
+                const Population2D<population_type> &population2D,
+                const MutationRates &uu,
+                const Symmetry &ss,
+                const SymmetricRenewal &rr)
+        : _population2D(population2D) {
+
+            assert(uu.size() == (population2D.number_species() - 1));
+            offspring_moments(population2D.number_species(), uu, ss, rr, _MM, _VV);
+        }
+
+        /**
+         * mean (moment = 1) or variance (moment = 2) of population sizes, \n
+         * indexed by (pop, spe, node) as the results of Moment_Statistics_Population
+         */
+        const array::Array3D<double> moments(const Uniform_Time_Grid<time_type> &time_grid, const int &moment) const {
+
+            assert(moment == 1 || moment == 2);
+
+            array::Array3D<double> results(_population2D.number_sub_pops(), number_species(), time_grid.size());
+
+            for (int pop = 0; pop < _population2D.number_sub_pops(); pop++) {
+
+                /* initial populations are known exactly */
+                std::vector<double> mm(number_species());
+                for (int spe = 0; spe < number_species(); spe++)
+                    mm.at(spe) = static_cast<double> (_population2D.at(pop, spe));
+                array::Array2D<double> CC(number_species(), number_species(), 0.0);
+
+                time_type time = static_cast<time_type> (0);
+                for (int node = 0; node < time_grid.size(); node++) {
+
+                    for (; time < time_grid.at(Node(node)); time++)
+                        advance(mm, CC);
+
+                    for (int spe = 0; spe < number_species(); spe++)
+                        results.at(pop, spe, node) = (moment == 1) ? mm.at(spe) : CC.at(spe, spe);
+                }
+            }
+
+            return results;
+        }
+
+    };
+
+    /**
+     * mean-field population sizes of the Moran processes simulated by Moran3, Moran4 and Moran5 \n
+     * \n
+     * integrates dn/dt = sum over reactions of (rate at n) * (change in n), with the rates of moran5::transition_rates \n
+     * evaluated at the mean populations, by the classical Runge-Kutta method; \n
+     * mean dynamics are linear, and the mean field is exact, while the last species is absent, \n
+     * since a replaced cell is then drawn from all N cells; \n
+     * once it is present, the rate at which its cells are replaced involves their correlation with other species \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    template <class population_type>
+    class Moran_Mean_Field {
+    private:
+
+        typedef double time_type;
+
+        enum {
+            number_species_padded = 5, // Moran3 and Moran4 delegate to Moran5 (the enum hack: Item 2)
+            steps_per_unit_time = 100 // rates per cell are at most of order one
+        };
+
+    private:
+
+        int _number_species; // of the model being solved, before padding
+        Population2D<double> _population2D; // padded to Moran5
+        MutationRates _uu;
+        Symmetry _ss;
+        long long int _NN;
+
+    private:
+
+        /**
+         * pad populations and mutation rates of Moran3 and Moran4 to those of Moran5 (see Moran3, Moran4) \n
+         * static function removes danger of accidentally referring to the nascent object's as-yet-uninitialized data members (item 9)
+         */
+        static const Population2D<double> pad_population(const Population2D<population_type> &population2D) {
+
+            Population2D<double> population2D_padded(population2D.number_sub_pops(), number_species_padded);
+            for (int pop = 0; pop < population2D.number_sub_pops(); pop++)
+                for (int spe = 0; spe < number_species_padded; spe++)
+                    population2D_padded.at(pop, spe) = spe < population2D.number_species() ? static_cast<double> (population2D.at(pop, spe)) : 0.0;
+
+            return population2D_padded;
+        }
+
+        static const MutationRates pad_mutation_rates(const MutationRates &uu) {
+
+            MutationRates uu_padded(number_species_padded - 1);
+            for (int spe = 0; spe < uu_padded.size(); spe++)
+                uu_padded.at(spe) = spe < uu.size() ? uu.at(spe) : static_cast<MutationRates::data_t> (0);
+
+            return uu_padded;
+        }
+
+        /**
+         * drift of populations nn
+         */
+        const Population2D<double> drift(const Population2D<double> &nn) const {
+
+            const array::Array4D<double> ww = moran5::transition_rates(nn, _uu, _ss.value(), _NN);
+
+            Population2D<double> dn(nn.number_sub_pops(), nn.number_species());
+            for (int pop = 0; pop < nn.number_sub_pops(); pop++)
+                for (int spe = 0; spe < nn.number_species(); spe++)
+                    dn.at(pop, spe) = 0.0;
+
+            for (int pop_dec = 0; pop_dec < ww.get_dim0(); pop_dec++)
+                for (int spe_dec = 0; spe_dec < ww.get_dim1(); spe_dec++)
+                    for (int pop_inc = 0; pop_inc < ww.get_dim2(); pop_inc++)
+                        for (int spe_inc = 0; spe_inc < ww.get_dim3(); spe_inc++) {
+                            const double rate = ww.at(pop_dec, spe_dec, pop_inc, spe_inc);
+                            dn.at(pop_dec, spe_dec) -= rate;
+                            dn.at(pop_inc, spe_inc) += rate;
+                        }
+
+            return dn;
+        }
+
+        /**
+         * nn + dn * hh
+         */
+        static const Population2D<double> add(const Population2D<double> &nn, const Population2D<double> &dn, const double &hh) {
+
+            Population2D<double> sum(nn);
+            for (int pop = 0; pop < nn.number_sub_pops(); pop++)
+                for (int spe = 0; spe < nn.number_species(); spe++)
+                    sum.at(pop, spe) += dn.at(pop, spe) * hh;
+
+            return sum;
+        }
+
+        /**
+         * one step of the classical Runge-Kutta method
+         */
+        void advance(Population2D<double> &nn, const double &hh) const {
+
+            const Population2D<double> k1 = drift(nn);
+            const Population2D<double> k2 = drift(add(nn, k1, 0.5 * hh));
+            const Population2D<double> k3 = drift(add(nn, k2, 0.5 * hh));
+            const Population2D<double> k4 = drift(add(nn, k3, hh));
+
+            nn = add(nn, k1, hh / 6.0);
+            nn = add(nn, k2, hh / 3.0);
+            nn = add(nn, k3, hh / 3.0);
+            nn = add(nn, k4, hh / 6.0);
+        }
+
+    public:
+
+        /**
+         * constructor \n
+         * parameters as for Moran3, Moran4 or Moran5
+         */
+        explicit Moran_Mean_Field(
+                const Population2D<population_type> &population2D,
+                const MutationRates &uu,
+                const Symmetry &ss)
+        : _number_species(population2D.number_species()),
+        _population2D(pad_population(population2D)), _uu(pad_mutation_rates(uu)), _ss(ss), _NN(population2D.sum()) {
+
+            assert(population2D.number_species() >= 3 && population2D.number_species() <= number_species_padded);
+            assert(uu.size() == (population2D.number_species() - 1));
+        }
+
+        /**
+         * mean population sizes (moment = 1), indexed by (pop, spe, node) as the results of Moment_Statistics_Population
+         */
+        const array::Array3D<double> moments(const Uniform_Time_Grid<time_type> &time_grid, const int &moment) const {
+
+            if (moment != 1) {
+                std::cerr << "mean-field dynamics of Moran processes give mean population sizes only" << std::endl;
+                assert(false);
+            }
+
+            array::Array3D<double> results(_population2D.number_sub_pops(), _number_species, time_grid.size());
+
+            Population2D<double> nn(_population2D);
+            time_type time = static_cast<time_type> (0);
+            for (int node = 0; node < time_grid.size(); node++) {
+
+                const time_type interval = time_grid.at(Node(node)) - time;
+                const int number_steps = static_cast<int> (std::ceil(interval * steps_per_unit_time));
+                for (int step = 0; step < number_steps; step++)
+                    advance(nn, interval / number_steps);
+                time = time_grid.at(Node(node));
+
+                for (int pop = 0; pop < _population2D.number_sub_pops(); pop++)
+                    for (int spe = 0; spe < _number_species; spe++)
+                        results.at(pop, spe, node) = nn.at(pop, spe);
+            }
+
+            return results;
+        }
+
+    };
+
+    namespace calculate_population_moments_detail {
+
+        /**
+         * engines that calculate moments of population sizes of each category of configuration (tag dispatch)
+         */
+        template <class population_type, class category>
+        struct Moments_Engine;
+
+        template <class population_type>
+        struct Moments_Engine<population_type, configuration_categories::branching_category> {
+
+            typedef Branching_Moments<population_type> type;
+
+            template <class Read_Policy_type>
+            static const type create(const Read_Policy_type &read_policy) {
+
+                return type(read_policy.get_population(), read_policy.getUu(), read_policy.getSymmetry(), read_policy.get_SymmetricRenewal());
+            }
+        };
+
+        template <class population_type>
+        struct Moments_Engine<population_type, configuration_categories::moran_category> {
+
+            typedef Moran_Mean_Field<population_type> type;
+
+            template <class Read_Policy_type>
+            static const type create(const Read_Policy_type &read_policy) {
+
+                return type(read_policy.get_population(), read_policy.getUu(), read_policy.getSymmetry());
+            }
+        };
+
+        /**
+         * print moments versus time for all sub-populations and all species, in the format of print_moment_populations
+         */
+        template <class time_type>
+        void store_moments(const std::string &label, const Uniform_Time_Grid<time_type> &time_grid, const array::Array3D<double> &results) {
+
+            for (int pop = 0; pop < results.get_dim0(); pop++) {
+
+                const std::string filename = label + "PopulationVersusTime__pop" + boost::lexical_cast<std::string > (pop) + ".dat";
+                boost::shared_ptr<std::ofstream> ofstream_ptr = open_file_for_output(filename);
+
+                for (int node = 0; node < results.get_dim2(); node++) {
+
+                    *ofstream_ptr << std::setw(30) << std::setprecision(20) << time_grid.at(Node(node));
+
+                    for (int spe = 0; spe < results.get_dim1(); spe++)
+                        *ofstream_ptr << std::setw(30) << std::setprecision(20) << results.at(pop, spe, node);
+
+                    *ofstream_ptr << std::endl;
+                }
+            }
+        }
+
+    }
+
+    /**
+     * calculate mean population sizes at the nodes of the time grid without simulation, \n
+     * and their variances if number_moments is 2 (branching configurations only): \n
+     * exactly for Branching_Discrete (see Branching_Moments) and in the mean field for Moran processes (see Moran_Mean_Field) \n
+     * input file is the one read by Calculate_Histogram_Trajs; \n
+     * means are written to the files of print_moment_populations, variances to "variancePopulationVersusTime__pop*.dat" \n
+     * function template not used for uniformity with Calculate_Histogram_Trajs
+     */
+    template <
+    class Configuration_Policy,
+    template <class Configuration_type> class Read_Policy = Read_Homeostasis_Policy
+    >
+    class Calculate_Population_Moments {
+    private:
+
+        typedef typename Configuration_Policy::time_t time_type; // Item 42
+        typedef typename Configuration_Policy::population_t population_type;
+        typedef calculate_population_moments_detail::Moments_Engine<population_type, typename Configuration_Policy::category> Engine_type;
+
+    public:
+
+        static const void implement(const int &number_moments = 1) {
+
+            /* set up policy object that reads input */
+            Read_Policy<Configuration_Policy> read_policy("main.in");
+
+            {
+                const typename Engine_type::type engine = Engine_type::create(read_policy);
+                const Uniform_Time_Grid<time_type> time_grid = read_policy.getTime_grid();
+
+                calculate_population_moments_detail::store_moments("mean", time_grid, engine.moments(time_grid, 1));
+                if (number_moments > 1)
+                    calculate_population_moments_detail::store_moments("variance", time_grid, engine.moments(time_grid, 2));
+            }
+
+            /* indicate that simulation has finished */
+            done();
+        }
+    };
+
+}
+
+#endif	/* CALCULATE_POPULATION_MOMENTS_H */
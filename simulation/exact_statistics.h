@@ -0,0 +1,89 @@
+#ifndef EXACT_STATISTICS_H
+#define	EXACT_STATISTICS_H
+
+#include <vector> // std::vector
+#include <string> // std::string
+#include <iomanip> // std::setw, etc
+
+#include <boost/lexical_cast.hpp> // boost::lexical_cast
+
+#include <mutation_accumulation/parameters/parameters_fwd.h> // Pop, Spe
+#include <mutation_accumulation/statistics/statistics/statistics_registry.h> // monte_carlo::Statistics_Registry
+#include <mutation_accumulation/simulation/files.h> // monte_carlo::open_file_for_output
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * write distributions that are not gathered directly from trajectories \n
+     * (see Branching_PGF, Moran_Master_Equation, Calculate_Factorized_Statistics) \n
+     * in the files, and formats, of the statistics that they replace
+     */
+    namespace exact_statistics {
+
+        /**
+         * write cdf at the points of sample space, in the format of probability::Histogram
+         */
+        template <class sample_type>
+        void store_cdf(const std::string &filename, const std::vector<sample_type> &sample_space, const std::vector<double> &cdf) {
+
+            assert(sample_space.size() == cdf.size());
+
+            const boost::shared_ptr<std::ofstream> ofstream_ptr = open_file_for_output(filename);
+
+            for (typename std::vector<sample_type>::size_type ii = 0; ii < sample_space.size(); ii++) {
+
+                *ofstream_ptr << std::setw(10) << std::setprecision(3) << sample_space.at(ii);
+                *ofstream_ptr << std::setw(20) << std::setprecision(10) << cdf.at(ii);
+                *ofstream_ptr << std::endl;
+
+            }
+        }
+
+        /**
+         * write the mutation-time CDFs tracked by Statistics_Mutation: \n
+         * the last species in the first sub-population (the observed cell), and cells selected in the input file \n
+         * Solver_type provides number_sub_pops(), number_species(), \n
+         * cdf(Pop, Spe, sample_space) and cdf(Spe, sample_space)
+         */
+        template <class Solver_type, class sample_type>
+        void store_mutation_cdfs(const Solver_type &solver, const std::vector<sample_type> &sample_space, const Statistics_Registry &registry) {
+
+            const Pop pop_to_observe(0);
+            const Spe spe_to_observe(solver.number_species() - 1);
+
+            for (int spe = 0; spe < solver.number_species(); spe++) {
+
+                for (int pop = 0; pop < solver.number_sub_pops(); pop++) {
+
+                    const bool observed = (pop == pop_to_observe.value()) && (spe == spe_to_observe.value());
+                    if (!(observed || registry.tracked(pop, spe, 0))) continue;
+
+                    const std::string filename = "histogram__pop" + boost::lexical_cast<std::string > (pop) + "__spe" + boost::lexical_cast<std::string > (spe) + "__xxx0.dat";
+                    store_cdf(filename, sample_space, solver.cdf(Pop(pop), Spe(spe), sample_space));
+                }
+
+                if (!registry.tracked_whole(spe, 0)) continue;
+
+                const std::string filename = "histogramWhole__spe" + boost::lexical_cast<std::string > (spe) + "__xxx0.dat";
+                store_cdf(filename, sample_space, solver.cdf(Spe(spe), sample_space));
+            }
+        }
+
+        /**
+         * write lifetime risk in the format of Calculate_Combined_Statistics
+         */
+        inline void store_lifetime_risk(const double &lifetime_risk) {
+
+            const boost::shared_ptr<std::ofstream> ofstream_ptr = open_file_for_output("lifetime_risk.dat");
+            *ofstream_ptr << std::setw(30) << std::setprecision(20);
+            *ofstream_ptr << lifetime_risk;
+            *ofstream_ptr << std::endl;
+        }
+
+    }
+
+}
+
+#endif	/* EXACT_STATISTICS_H */
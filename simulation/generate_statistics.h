@@ -3,14 +3,22 @@
 
 //#define DEBUG_GENERATE_STATISTICS
 
+#include <ctime> // std::time
+#include <iostream> // std::cerr
+#include <cassert> // assert
+
 #include <boost/static_assert.hpp> // BOOST_STATIC_ASSERT
 #include <boost/type_traits/is_base_of.hpp> //  boost::is_base_of
 
 #include <mutation_accumulation/configuration/configuration/random_fwd.h> // monte_carlo::base_generator_type
 #include <mutation_accumulation/configuration/configuration/configuration_interface.h> // monte_carlo::Configuration_Interface
+#include <mutation_accumulation/configuration/configuration/path_policy.h> // monte_carlo::Path_Policy_Base
+#include <mutation_accumulation/configuration/utilities/fpt_extinction.h> // monte_carlo::extinction_time_whole
 #include <mutation_accumulation/statistics/statistics/statistics_gatherer.h> // monte_carlo::Statistics_Gatherer
+#include <mutation_accumulation/configuration/utilities/trial_summary.h> // monte_carlo::Trial_Summary
 
 #include "raw_data.h"
+#include "seeding_policy.h"
 
 /*************************************************************************/
 
@@ -67,16 +75,31 @@ namespace monte_carlo {
      * calculate statistics (defined by statistics policy) of stochastic process (defined by configuration policy)\n
      * path policy defines whether given stochastic path is successful\n
      * Raw_Data_Policy defines whether and how to print out random samples \n
+     * Seeding_Policy defines how the generator is seeded at the start of each trial \n
      * strategy/policy design pattern\n
      * static (compile-time) polymorphism via templates \n
      * function template not used because default template parameters not allowed in function templates
      */
-    template <class Path_Policy, class Configuration_Policy, class Statistics_Policy, template <class Configuration_type> class Raw_Data_Policy = Raw_Data_Null>
+    template <class Path_Policy, class Configuration_Policy, class Statistics_Policy, template <class Configuration_type> class Raw_Data_Policy = Raw_Data_Null, class Seeding_Policy = Continuous_Stream>
     class Generate_Statistics {
     public:
 
+        /**
+         * seed generator with the current time
+         */
         static const Path_Policy implement(const Configuration_Policy &configuration_init, Statistics_Policy &statistics) {
 
+            return implement(configuration_init, statistics, static_cast<unsigned int> (std::time(0)));
+        }
+
+        /**
+         * seed generator explicitly \n
+         * runs started at the same time (e.g. on different threads) need different seeds \n
+         * trials are numbered from first_trial, so that a run topping up statistics of an earlier run \n
+         * with the same seed continues, rather than repeats, its per-trial streams (see Per_Trial_Streams)
+         */
+        static const Path_Policy implement(const Configuration_Policy &configuration_init, Statistics_Policy &statistics, const unsigned int &seed, const long long int &first_trial = 0) {
+
             /* typedefs */
             typedef typename Configuration_Policy::time_t time_t;
             typedef typename Configuration_Policy::population_t population_t;
@@ -89,7 +112,7 @@ namespace monte_carlo {
             BOOST_STATIC_ASSERT((boost::is_base_of<Raw_Data_Policy_Base<Configuration_Policy>, Raw_Data_Policy<Configuration_Policy> >::value));
 
             /* PRNG */
-            base_generator_type base_rand_gen(std::time(0)); // static_cast<unsigned int> (0)
+            base_generator_type base_rand_gen(seed);
 
             /* path policy object determines how to handle the paths */
             Path_Policy path_policy;
@@ -97,8 +120,14 @@ namespace monte_carlo {
             /* set up policy object that handles the printing of raw data */
             Raw_Data_Policy<Configuration_Policy> raw_data_policy;
 
+            /* stop updating sub-populations whose fate is decided, unless statistics still need them */
+            const bool freeze_decided = !statistics.needs_decided_sub_pops();
+
             /* perform multiple trials of the stochastic process */
-            while (!statistics.converged()) {
+            for (long long int trial = first_trial; !statistics.converged(); trial++) {
+
+                /* (re)seed generator according to seeding policy */
+                Seeding_Policy::start_trial(base_rand_gen, seed, trial);
 
                 /* record initial state of random number generator */
                 base_generator_type base_rand_gen_init(base_rand_gen);
@@ -107,22 +136,43 @@ namespace monte_carlo {
                  * could initialize with a random configuration */
                 Configuration_Policy configuration(configuration_init);
 
+                /* stream path populations to statistics that need them, rather than storing the path */
+                if (statistics.listens_to_nodes())
+                    configuration.attach_node_listener(&statistics);
+
+                /* first-passage data of the trial, shared by path policy, statistics and raw data policy */
+                Trial_Summary<Configuration_Policy> summary(configuration);
+
                 /* generate trajectory of the stochastic process */
-                while (!path_policy.terminate(configuration))
+                while (!path_policy.terminate(summary)) {
                     configuration.transition(base_rand_gen);
+                    summary.update(configuration);
+                    if (freeze_decided) path_policy.freeze_decided(summary, configuration);
+                }
+
+                /* a trajectory that went extinct stays extinct: stream its populations to the nodes it did not reach, \n
+                 * so that path statistics count it at every node; \n
+                 * other trajectories must run for the whole time span, since populations at later nodes are unknown */
+                if (statistics.listens_to_nodes() && !summary.end()) {
+                    if (!summary.extinguished()) {
+                        std::cerr << "path populations need trajectories that run for the whole time span or go extinct" << std::endl;
+                        assert(false);
+                    }
+                    configuration.complete_path();
+                }
 
 #ifdef DEBUG_GENERATE_STATISTICS
                 print_debug_info(configuration);
 #endif
 
                 /* gather statistics from the stochastic process */
-                statistics.dump(configuration);
+                statistics.dump(configuration, summary);
 
                 /* print raw data to disk */
-                raw_data_policy.print(configuration);
+                raw_data_policy.print(summary);
 
                 /* save initial PRNG state if path was successful */
-                path_policy.record_success(configuration, base_rand_gen_init);
+                path_policy.record_success(summary, base_rand_gen_init, freeze_decided);
 
             }
 
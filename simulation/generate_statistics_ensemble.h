@@ -0,0 +1,364 @@
+#ifndef GENERATE_STATISTICS_ENSEMBLE_H
+#define	GENERATE_STATISTICS_ENSEMBLE_H
+
+#include <vector> // std::vector
+#include <map> // std::map
+#include <algorithm> // std::fill
+#include <iostream> // std::cerr
+#include <cassert> // assert
+
+#include <boost/shared_ptr.hpp> // boost::shared_ptr
+#include <boost/static_assert.hpp> // BOOST_STATIC_ASSERT
+#include <boost/type_traits/is_base_of.hpp> //  boost::is_base_of
+#include <boost/random/binomial_distribution.hpp> // boost::random::binomial_distribution
+
+#include <mutation_accumulation/configuration/configuration/random_fwd.h> // monte_carlo::base_generator_type
+#include <mutation_accumulation/configuration/configuration/branching_discrete.h> // monte_carlo::Branching_Discrete
+#include <mutation_accumulation/configuration/configuration/path_policy.h> // monte_carlo::Path_Policy_Base
+#include <mutation_accumulation/statistics/statistics/statistics_gatherer.h> // monte_carlo::Statistics_Gatherer
+#include <mutation_accumulation/configuration/utilities/trial_summary.h> // monte_carlo::Trial_Summary
+
+#include "raw_data.h"
+#include "seeding_policy.h"
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace generate_statistics_ensemble_detail {
+
+        /**
+         * populations of a fixed number of Branching_Discrete trajectories (lanes), which advance one generation at a time in lockstep \n
+         * \n
+         * populations are held in structure-of-arrays layout: the lanes of each (pop, spe) cell are contiguous, \n
+         * so that a generation streams through memory once, and the population update is a single loop that the compiler may vectorize; \n
+         * conditional probabilities of the multinomial draws (see mutation_accumulation::random::multinomial_distribution) \n
+         * are calculated once per species, rather than once per cell per generation, and no memory is allocated per draw \n
+         * \n
+         * a lane draws its divisions from its own generator, in the order in which Branching_Discrete draws them, \n
+         * so that a lane reproduces the trajectory that Branching_Discrete generates from the same stream \n
+         * compiler-generated copy constructor and assignment operator are fine
+         */
+        template <class population_type>
+        class Branching_Ensemble {
+        private:
+
+            typedef Branching_Discrete<population_type> Configuration_type;
+            typedef boost::random::binomial_distribution<population_type, double> binomial_distribution_type;
+
+        public:
+
+            /**
+             * number of reaction categories of a division (see branching_discrete::categorical_probabilities) \n
+             * enum hack (Item 2)
+             */
+            enum {
+                number_categories = 5
+            };
+
+        private:
+
+            int _width;
+            int _number_sub_pops;
+            int _number_species;
+
+            std::vector<population_type> _populations; // element ((pop * number_species) + spe) * width + lane
+            std::vector<population_type> _changes; // changes in populations during the current generation, in the same layout
+
+            /** probability of each reaction category, given that the division lies in none of the earlier categories, for each species */
+            std::vector<std::vector<double> > _conditional_probabilities;
+
+            std::vector<population_type> _division_counts; // scratch space for the draws of a single cell
+
+        private:
+
+            const int index(const int &pop, const int &spe, const int &lane) const {
+
+                return ((pop * _number_species) + spe) * _width + lane;
+            }
+
+        public:
+
+            /**
+             * constructor \n
+             * lanes simulate the process of configuration
+             */
+            explicit Branching_Ensemble(const Configuration_type &configuration, const int &width)
+            : _width(width),
+            _number_sub_pops(configuration.number_sub_pops()),
+            _number_species(configuration.number_species()),
+            _populations(configuration.number_sub_pops() * configuration.number_species() * width, static_cast<population_type> (0)),
+            _changes(configuration.number_sub_pops() * configuration.number_species() * width, static_cast<population_type> (0)),
+            _division_counts(number_categories, static_cast<population_type> (0)) {
+
+                assert(width > 0);
+
+                /* as in multinomial_distribution: p_bar = p / (1 - sum of probabilities of earlier categories) */
+                for (int spe = 0; spe < _number_species; spe++) {
+
+                    const std::vector<double> probabilities = configuration.division_probabilities(Spe(spe));
+                    assert(probabilities.size() == number_categories);
+
+                    std::vector<double> conditional_probabilities(number_categories - 1);
+                    double qq = 1.0;
+                    for (int cat = 0; cat < (number_categories - 1); cat++) {
+                        conditional_probabilities.at(cat) = probabilities.at(cat) / qq;
+                        qq -= probabilities.at(cat);
+                    }
+                    _conditional_probabilities.push_back(conditional_probabilities);
+                }
+            }
+
+            const int width() const {
+
+                return _width;
+            }
+
+            /**
+             * copy populations of configuration into lane
+             */
+            void load(const int &lane, const Configuration_type &configuration) {
+
+                for (int pop = 0; pop < _number_sub_pops; pop++)
+                    for (int spe = 0; spe < _number_species; spe++)
+                        _populations.at(index(pop, spe, lane)) = configuration.get_population(Pop(pop), Spe(spe));
+            }
+
+            /**
+             * copy populations of lane into population2D
+             */
+            void store(const int &lane, Population2D<population_type> &population2D) const {
+
+                for (int pop = 0; pop < _number_sub_pops; pop++)
+                    for (int spe = 0; spe < _number_species; spe++)
+                        population2D.at(pop, spe) = _populations.at(index(pop, spe, lane));
+            }
+
+            /**
+             * advance by one generation the lanes that are flagged in advancing \n
+             * sub-populations that the configuration of a lane has frozen are not updated
+             */
+            void advance(
+                    const std::vector<bool> &advancing,
+                    const std::vector<boost::shared_ptr<Configuration_type> > &configurations,
+                    std::vector<base_generator_type> &base_rand_gens) {
+
+                std::fill(_changes.begin(), _changes.end(), static_cast<population_type> (0));
+
+                for (int pop = 0; pop < _number_sub_pops; pop++) {
+
+                    for (int spe = 0; spe < _number_species; spe++) {
+
+                        const std::vector<double> &pp = _conditional_probabilities.at(spe);
+                        const int first = index(pop, spe, 0);
+
+                        for (int lane = 0; lane < _width; lane++) {
+
+                            if (!advancing.at(lane)) continue;
+                            if (configurations.at(lane)->frozen(Pop(pop))) continue;
+
+                            /* multinomial_distribution draws nothing from an empty cell */
+                            const population_type NN = _populations.at(first + lane);
+                            if (NN == static_cast<population_type> (0)) continue;
+
+                            population_type NN_bar = NN;
+                            for (int cat = 0; cat < (number_categories - 1); cat++) {
+                                _division_counts.at(cat) = binomial_distribution_type(NN_bar, pp.at(cat))(base_rand_gens.at(lane));
+                                NN_bar -= _division_counts.at(cat);
+                            }
+                            _division_counts.back() = NN_bar;
+
+                            _changes.at(first + lane) += Configuration_type::change_from_current_species(_division_counts);
+                            if (spe < (_number_species - 1))
+                                _changes.at(first + _width + lane) += Configuration_type::change_to_next_species(_division_counts);
+                        }
+                    }
+                }
+
+                /* all cells divide at once, from the populations of the previous generation */
+                for (typename std::vector<population_type>::size_type ii = 0; ii < _populations.size(); ii++)
+                    _populations[ii] += _changes[ii];
+            }
+
+        };
+
+        /**
+         * trajectory that has terminated, and waits for the trajectories of earlier trials to terminate
+         */
+        template <class Configuration_type>
+        struct Finished_Trial {
+            boost::shared_ptr<Configuration_type> configuration;
+            boost::shared_ptr<Trial_Summary<Configuration_type> > summary;
+            base_generator_type base_rand_gen_init;
+        };
+
+    }
+
+    /**
+     * calculate statistics of Branching_Discrete as Generate_Statistics does, \n
+     * advancing width trajectories (lanes) in lockstep, one generation at a time (see Branching_Ensemble) \n
+     * \n
+     * a lane whose trajectory terminates is refilled with the next trial, \n
+     * unless trials_in_flight_per_lane * width trials have been started but not gathered, \n
+     * so that a long trajectory cannot make terminated trials, each holding a configuration, pile up without bound; \n
+     * trials are passed to the statistics in order of trial number, so that the trials gathered before convergence are \n
+     * the same as those of Generate_Statistics (trials in flight at convergence are discarded); \n
+     * with Per_Trial_Streams, results are identical to those of Generate_Statistics; \n
+     * with Continuous_Stream, each lane draws from its own stream, seeded from seed \n
+     * \n
+     * statistics may not listen to nodes, whose values would arrive interleaved across trials, \n
+     * and the process may not be tilted, nor accumulate a score, nor update sub-populations from their own streams \n
+     * function template not used because default template parameters not allowed in function templates
+     */
+    template <class Path_Policy, class population_type, class Statistics_Policy, template <class Configuration_type> class Raw_Data_Policy = Raw_Data_Null, class Seeding_Policy = Continuous_Stream>
+    class Generate_Statistics_Ensemble {
+    private:
+
+        typedef Branching_Discrete<population_type> Configuration_Policy;
+        typedef Trial_Summary<Configuration_Policy> Summary_type;
+        typedef generate_statistics_ensemble_detail::Finished_Trial<Configuration_Policy> Finished_Trial_type;
+
+    public:
+
+        /**
+         * default number of lanes \n
+         * enum hack (Item 2)
+         */
+        enum {
+            default_width = 16,
+            trials_in_flight_per_lane = 4 // bounds the trials started but not yet gathered (see implement)
+        };
+
+        /**
+         * seed generator explicitly \n
+         * trials are numbered from first_trial (see Generate_Statistics)
+         */
+        static const Path_Policy implement(
+                const Configuration_Policy &configuration_init,
+                Statistics_Policy &statistics,
+                const unsigned int &seed,
+                const long long int &first_trial = 0,
+                const int &width = default_width) {
+
+            /* typedefs */
+            typedef typename Configuration_Policy::time_t time_t;
+            typedef typename Statistics_Policy::Results_t Results_t;
+
+            /* check policy type to supplement "duck typing" */
+            BOOST_STATIC_ASSERT((boost::is_base_of<Path_Policy_Base<Configuration_Policy>, Path_Policy>::value));
+            BOOST_STATIC_ASSERT((boost::is_base_of<Statistics_Gatherer<Configuration_Policy, Results_t>, Statistics_Policy>::value));
+            BOOST_STATIC_ASSERT((boost::is_base_of<Raw_Data_Policy_Base<Configuration_Policy>, Raw_Data_Policy<Configuration_Policy> >::value));
+
+            if (statistics.listens_to_nodes()) {
+                std::cerr << "ensembles cannot stream path populations to statistics" << std::endl;
+                assert(false);
+            }
+
+            if (configuration_init.tilted() || !configuration_init.score().empty()) {
+                std::cerr << "ensembles do not weight paths by likelihood ratios, nor accumulate scores" << std::endl;
+                assert(false);
+            }
+
+            if (configuration_init.sub_pop_threads() != 0) {
+                std::cerr << "ensembles draw divisions from the streams of lanes, not of sub-populations" << std::endl;
+                assert(false);
+            }
+
+            /* path policy object determines how to handle the paths */
+            Path_Policy path_policy;
+
+            /* set up policy object that handles the printing of raw data */
+            Raw_Data_Policy<Configuration_Policy> raw_data_policy;
+
+            /* stop updating sub-populations whose fate is decided, unless statistics still need them */
+            const bool freeze_decided = !statistics.needs_decided_sub_pops();
+
+            /* one PRNG per lane, seeded from a master PRNG so that continuous streams of lanes differ */
+            base_generator_type master_rand_gen(seed);
+            std::vector<base_generator_type> base_rand_gens;
+            for (int lane = 0; lane < width; lane++)
+                base_rand_gens.push_back(base_generator_type(master_rand_gen()));
+            std::vector<base_generator_type> base_rand_gens_init(base_rand_gens);
+
+            /* state of each lane; a lane is idle if it has no configuration */
+            generate_statistics_ensemble_detail::Branching_Ensemble<population_type> ensemble(configuration_init, width);
+            std::vector<boost::shared_ptr<Configuration_Policy> > configurations(width);
+            std::vector<boost::shared_ptr<Summary_type> > summaries(width);
+            std::vector<long long int> trials(width, first_trial);
+            std::vector<bool> advancing(width, false);
+            Population2D<population_type> population2D(configuration_init.number_sub_pops(), configuration_init.number_species());
+
+            /* terminated trajectories, by trial number, until statistics of earlier trials have been gathered */
+            std::map<long long int, Finished_Trial_type> finished_trials;
+            long long int next_trial = first_trial;
+            long long int next_trial_to_dump = first_trial;
+            const long long int maximum_trials_in_flight = static_cast<long long int> (trials_in_flight_per_lane) * width;
+
+            while (!statistics.converged()) {
+
+                /* start new trials in idle lanes */
+                for (int lane = 0; lane < width; lane++) {
+
+                    if (configurations.at(lane)) continue;
+
+                    /* leave lane idle until the earliest trial in flight has been gathered \n
+                     * (that trial occupies a lane, so the ensemble keeps advancing) */
+                    if (next_trial - next_trial_to_dump >= maximum_trials_in_flight) break;
+
+                    Seeding_Policy::start_trial(base_rand_gens.at(lane), seed, next_trial);
+                    base_rand_gens_init.at(lane) = base_rand_gens.at(lane);
+
+                    configurations.at(lane).reset(new Configuration_Policy(configuration_init));
+                    summaries.at(lane).reset(new Summary_type(*configurations.at(lane)));
+                    trials.at(lane) = next_trial++;
+                    ensemble.load(lane, *configurations.at(lane));
+                }
+
+                /* generate one generation of every trajectory that has not terminated */
+                for (int lane = 0; lane < width; lane++)
+                    advancing.at(lane) = configurations.at(lane) && !path_policy.terminate(*summaries.at(lane));
+
+                ensemble.advance(advancing, configurations, base_rand_gens);
+
+                for (int lane = 0; lane < width; lane++) {
+
+                    if (advancing.at(lane)) {
+                        ensemble.store(lane, population2D);
+                        configurations.at(lane)->transition_to(population2D, configurations.at(lane)->get_time() + static_cast<time_t> (1));
+                        summaries.at(lane)->update(*configurations.at(lane));
+                        if (freeze_decided) path_policy.freeze_decided(*summaries.at(lane), *configurations.at(lane));
+                    }
+
+                    /* retire terminated trajectories */
+                    if (configurations.at(lane) && path_policy.terminate(*summaries.at(lane))) {
+                        Finished_Trial_type &finished_trial = finished_trials[trials.at(lane)];
+                        finished_trial.configuration = configurations.at(lane);
+                        finished_trial.summary = summaries.at(lane);
+                        finished_trial.base_rand_gen_init = base_rand_gens_init.at(lane);
+                        configurations.at(lane).reset();
+                        summaries.at(lane).reset();
+                    }
+                }
+
+                /* gather statistics of terminated trials in order of trial number */
+                typename std::map<long long int, Finished_Trial_type>::iterator it = finished_trials.find(next_trial_to_dump);
+                while ((it != finished_trials.end()) && !statistics.converged()) {
+
+                    statistics.dump(*it->second.configuration, *it->second.summary);
+                    raw_data_policy.print(*it->second.summary);
+                    path_policy.record_success(*it->second.summary, it->second.base_rand_gen_init, freeze_decided);
+
+                    finished_trials.erase(it);
+                    it = finished_trials.find(++next_trial_to_dump);
+                }
+            }
+
+            return path_policy;
+
+        }
+
+    };
+
+}
+
+#endif	/* GENERATE_STATISTICS_ENSEMBLE_H */
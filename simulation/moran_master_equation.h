@@ -0,0 +1,393 @@
+#ifndef MORAN_MASTER_EQUATION_H
+#define	MORAN_MASTER_EQUATION_H
+
+#include <vector> // std::vector
+#include <map> // std::map
+#include <cmath> // std::exp, std::ceil
+#include <algorithm> // std::max
+#include <cassert> // assert
+#include <string> // std::string
+#include <stdexcept> // std::length_error
+
+#include <boost/static_assert.hpp> // BOOST_STATIC_ASSERT
+#include <boost/type_traits/is_same.hpp> // boost::is_same
+#include <boost/lexical_cast.hpp> // boost::lexical_cast
+
+#include <mutation_accumulation/parameters/parameters_fwd.h> // Symmetry, etc
+#include <mutation_accumulation/array/array4D.h> // array::Array4D
+#include <mutation_accumulation/utility/grid.h> // grid::make_uniform_grid
+#include <mutation_accumulation/utility/configuration_traits.h> // configuration_categories::moran_category
+#include <mutation_accumulation/configuration/configuration/population2D.h> // monte_carlo::Population2D
+#include <mutation_accumulation/configuration/configuration/mutation_rates.h> // monte_carlo::MutationRates
+#include <mutation_accumulation/configuration/configuration/time_grid.h> // monte_carlo::Uniform_Time_Grid
+#include <mutation_accumulation/configuration/configuration/moran5.h> // moran5::transition_rates
+#include <mutation_accumulation/simulation/read_policy.h> // monte_carlo::Read_Homeostasis_Policy
+#include <mutation_accumulation/simulation/files.h> // monte_carlo::done
+#include <mutation_accumulation/simulation/exact_statistics.h> // monte_carlo::exact_statistics::store_mutation_cdfs, etc
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace moran_master_equation_detail {
+
+        /**
+         * sparse generator of a continuous-time Markov chain, stored by rows (source states) \n
+         * state 0 is absorbing
+         */
+        struct Generator {
+            std::vector<int> row_start; // transitions out of state ii are row_start[ii] ... row_start[ii + 1] - 1
+            std::vector<int> target;
+            std::vector<double> rate;
+            std::vector<double> exit_rate; // total rate out of each state
+
+            const int number_states() const {
+
+                return exit_rate.size();
+            }
+        };
+
+    }
+
+    /**
+     * exact mutation-time distributions of the Moran processes simulated by Moran3, Moran4 and Moran5 \n
+     * \n
+     * enumerates the states reachable from the initial state, with the rates of moran5::transition_rates, \n
+     * and lumps every state in which the target species is present into a single absorbing state; \n
+     * the probability of the absorbing state at time t, i.e. the CDF of the time at which the target species arises, \n
+     * follows from the master equation by uniformization: \n
+     * p(t) = sum_k Poisson(k; Lambda t) p(0) P^k, where P = I + Q / Lambda and Lambda is the largest exit rate \n
+     * \n
+     * the number of states grows as N^(number of species - 1) for a single sub-population of N cells, \n
+     * so the solver suits single crypts of up to a few hundred cells, \n
+     * and throws std::length_error when the states outnumber maximum_number_states; \n
+     * cost is O(Lambda * time span * number of transitions) per target \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    template <class population_type>
+    class Moran_Master_Equation {
+    private:
+
+        typedef double time_type;
+        typedef std::vector<population_type> state_type; // populations of all sub-populations and species, in row-major order
+        typedef moran_master_equation_detail::Generator Generator;
+
+        enum {
+            number_species_padded = 5, // Moran3 and Moran4 delegate to Moran5 (the enum hack: Item 2)
+            maximum_number_states = 2000000,
+            maximum_poisson_mean = 32 // Lambda * step; e^(-Lambda * step) must not underflow
+        };
+
+    private:
+
+        int _number_species; // of the model being solved, before padding
+        Population2D<population_type> _population2D;
+        MutationRates _uu;
+        Symmetry _ss;
+        long long int _NN;
+
+    private:
+
+        /**
+         * pad populations and mutation rates of Moran3 and Moran4 to those of Moran5 (see Moran3, Moran4) \n
+         * static function removes danger of accidentally referring to the nascent object's as-yet-uninitialized data members (item 9)
+         */
+        static const Population2D<population_type> pad_population(const Population2D<population_type> &population2D) {
+
+            Population2D<population_type> population2D_padded(population2D.number_sub_pops(), number_species_padded);
+            for (int pop = 0; pop < population2D.number_sub_pops(); pop++)
+                for (int spe = 0; spe < number_species_padded; spe++)
+                    population2D_padded.at(pop, spe) = spe < population2D.number_species() ? population2D.at(pop, spe) : static_cast<population_type> (0);
+
+            return population2D_padded;
+        }
+
+        static const MutationRates pad_mutation_rates(const MutationRates &uu) {
+
+            MutationRates uu_padded(number_species_padded - 1);
+            for (int spe = 0; spe < uu_padded.size(); spe++)
+                uu_padded.at(spe) = spe < uu.size() ? uu.at(spe) : static_cast<MutationRates::data_t> (0);
+
+            return uu_padded;
+        }
+
+        const state_type to_state(const Population2D<population_type> &population2D) const {
+
+            state_type state;
+            for (int pop = 0; pop < population2D.number_sub_pops(); pop++)
+                for (int spe = 0; spe < population2D.number_species(); spe++)
+                    state.push_back(population2D.at(pop, spe));
+
+            return state;
+        }
+
+        const Population2D<population_type> to_population(const state_type &state) const {
+
+            Population2D<population_type> population2D(_population2D.number_sub_pops(), number_species_padded);
+            for (int pop = 0; pop < population2D.number_sub_pops(); pop++)
+                for (int spe = 0; spe < population2D.number_species(); spe++)
+                    population2D.at(pop, spe) = state.at(pop * number_species_padded + spe);
+
+            return population2D;
+        }
+
+        /**
+         * true if species spe is present in any of sub-populations pops
+         */
+        const bool absorbed(const state_type &state, const std::vector<int> &pops, const int &spe) const {
+
+            for (std::vector<int>::size_type ii = 0; ii < pops.size(); ii++)
+                if (state.at(pops.at(ii) * number_species_padded + spe) > static_cast<population_type> (0))
+                    return true;
+
+            return false;
+        }
+
+        /**
+         * enumerate the states reachable from the initial state before species spe arises in one of sub-populations pops, \n
+         * and build the generator of the chain in which such states are absorbing \n
+         * returns the index of the initial state \n
+         * throws std::length_error, rather than exhausting memory, if there are more than maximum_number_states states
+         */
+        const int build_generator(const std::vector<int> &pops, const int &spe, Generator &generator) const {
+
+            /* absorbing state has no transitions */
+            generator.row_start.push_back(0);
+            generator.row_start.push_back(0);
+            generator.exit_rate.push_back(0.0);
+
+            const state_type state_init = to_state(_population2D);
+            if (absorbed(state_init, pops, spe)) return 0;
+
+            std::map<state_type, int> index;
+            std::vector<state_type> states(1); // states.at(0) stands for the absorbing state
+            index[state_init] = states.size();
+            states.push_back(state_init);
+
+            for (typename std::vector<state_type>::size_type ii = 1; ii < states.size(); ii++) {
+
+                const array::Array4D<double> ww = moran5::transition_rates(to_population(states.at(ii)), _uu, _ss.value(), _NN);
+                double exit_rate = 0.0;
+
+                for (int pop_dec = 0; pop_dec < ww.get_dim0(); pop_dec++)
+                    for (int spe_dec = 0; spe_dec < ww.get_dim1(); spe_dec++)
+                        for (int pop_inc = 0; pop_inc < ww.get_dim2(); pop_inc++)
+                            for (int spe_inc = 0; spe_inc < ww.get_dim3(); spe_inc++) {
+
+                                const double rate = ww.at(pop_dec, spe_dec, pop_inc, spe_inc);
+                                if (!(rate > 0.0)) continue;
+
+                                /* execute reaction (see Moran5::update_populations_gillespie) */
+                                state_type state(states.at(ii));
+                                state.at(pop_dec * number_species_padded + spe_dec) -= static_cast<population_type> (1);
+                                state.at(pop_inc * number_species_padded + spe_inc) += static_cast<population_type> (1);
+
+                                int target = 0;
+                                if (!absorbed(state, pops, spe)) {
+                                    typename std::map<state_type, int>::const_iterator it = index.find(state);
+                                    if (it != index.end()) {
+                                        target = it->second;
+                                    } else {
+                                        target = states.size();
+                                        index[state] = target;
+                                        states.push_back(state);
+                                    }
+                                }
+
+                                generator.target.push_back(target);
+                                generator.rate.push_back(rate);
+                                exit_rate += rate;
+                            }
+
+                generator.row_start.push_back(generator.target.size());
+                generator.exit_rate.push_back(exit_rate);
+
+                if (states.size() > maximum_number_states)
+                    throw std::length_error("master equation has more than " + boost::lexical_cast<std::string > (static_cast<int> (maximum_number_states)) + " states: use Monte Carlo simulation");
+            }
+
+            return 1;
+        }
+
+        /**
+         * one step of the uniformized chain: pp <- pp (I + Q / Lambda)
+         */
+        static void step(const Generator &generator, const double &Lambda, const std::vector<double> &pp, std::vector<double> &pp_next) {
+
+            for (int ii = 0; ii < generator.number_states(); ii++)
+                pp_next.at(ii) = pp.at(ii) * (1.0 - generator.exit_rate.at(ii) / Lambda);
+
+            for (int ii = 0; ii < generator.number_states(); ii++) {
+                if (pp.at(ii) == 0.0) continue;
+                const double flux = pp.at(ii) / Lambda;
+                for (int jj = generator.row_start.at(ii); jj < generator.row_start.at(ii + 1); jj++)
+                    pp_next.at(generator.target.at(jj)) += flux * generator.rate.at(jj);
+            }
+        }
+
+        /**
+         * evolve probabilities pp over time interval dt by uniformization \n
+         * the interval is split so that the Poisson weights neither underflow nor need many terms
+         */
+        static void advance(const Generator &generator, const double &Lambda, const time_type &dt, std::vector<double> &pp) {
+
+            if (!(dt > 0.0) || !(Lambda > 0.0)) return;
+
+            const double tolerance = 1e-14; // Poisson mass neglected per step
+            const int number_steps = static_cast<int> (std::ceil(Lambda * dt / maximum_poisson_mean));
+            const double poisson_mean = Lambda * dt / number_steps;
+
+            std::vector<double> vv(pp.size()), vv_next(pp.size()), pp_next(pp.size());
+            for (int step_number = 0; step_number < number_steps; step_number++) {
+
+                vv = pp;
+                double weight = std::exp(-poisson_mean);
+                double weight_cumulative = weight;
+                for (std::vector<double>::size_type ii = 0; ii < pp.size(); ii++)
+                    pp_next.at(ii) = weight * vv.at(ii);
+
+                for (int kk = 1; weight_cumulative < 1.0 - tolerance; kk++) {
+                    step(generator, Lambda, vv, vv_next);
+                    vv.swap(vv_next);
+                    weight *= poisson_mean / kk;
+                    weight_cumulative += weight;
+                    for (std::vector<double>::size_type ii = 0; ii < pp.size(); ii++)
+                        pp_next.at(ii) += weight * vv.at(ii);
+                }
+
+                pp.swap(pp_next);
+            }
+        }
+
+        /**
+         * probability that species spe has arisen in one of sub-populations pops by each of times (non-decreasing)
+         */
+        const std::vector<double> cdf(const std::vector<int> &pops, const Spe &spe, const std::vector<time_type> &times) const {
+
+            Generator generator;
+            const int state_init = build_generator(pops, spe.value(), generator);
+
+            double Lambda = 0.0;
+            for (int ii = 0; ii < generator.number_states(); ii++)
+                Lambda = std::max(Lambda, generator.exit_rate.at(ii));
+
+            std::vector<double> pp(generator.number_states(), 0.0);
+            pp.at(state_init) = 1.0;
+
+            std::vector<double> cdf_values;
+            time_type time = static_cast<time_type> (0);
+            for (typename std::vector<time_type>::size_type ii = 0; ii < times.size(); ii++) {
+                advance(generator, Lambda, times.at(ii) - time, pp);
+                time = times.at(ii);
+                cdf_values.push_back(pp.at(0));
+            }
+
+            return cdf_values;
+        }
+
+    public:
+
+        /**
+         * constructor \n
+         * parameters as for Moran3, Moran4 or Moran5
+         */
+        explicit Moran_Master_Equation(
+                const Population2D<population_type> &population2D,
+                const MutationRates &uu,
+                const Symmetry &ss)
+        : _number_species(population2D.number_species()),
+        _population2D(pad_population(population2D)), _uu(pad_mutation_rates(uu)), _ss(ss), _NN(population2D.sum()) {
+
+            assert(population2D.number_species() >= 3 && population2D.number_species() <= number_species_padded);
+            assert(uu.size() == (population2D.number_species() - 1));
+        }
+
+        const int number_sub_pops() const {
+
+            return _population2D.number_sub_pops();
+        }
+
+        const int number_species() const {
+
+            return _number_species;
+        }
+
+        /**
+         * probability that species spe has arisen in sub-population pop by each of times (non-decreasing)
+         */
+        const std::vector<double> cdf(const Pop &pop, const Spe &spe, const std::vector<time_type> &times) const {
+
+            return cdf(std::vector<int>(1, pop.value()), spe, times);
+        }
+
+        /**
+         * probability that species spe has arisen in any sub-population by each of times (non-decreasing)
+         */
+        const std::vector<double> cdf(const Spe &spe, const std::vector<time_type> &times) const {
+
+            std::vector<int> pops;
+            for (int pop = 0; pop < number_sub_pops(); pop++)
+                pops.push_back(pop);
+
+            return cdf(pops, spe, times);
+        }
+
+        /**
+         * probability that the last species arises in any sub-population within time span
+         */
+        const double lifetime_risk(const time_type &time_span) const {
+
+            return cdf(Spe(number_species() - 1), std::vector<time_type>(1, time_span)).back();
+        }
+
+    };
+
+    /**
+     * calculate mutation-time CDFs and lifetime risk of Moran3, Moran4 or Moran5 exactly (see Moran_Master_Equation) \n
+     * input file and output files are those of Calculate_Branching_PGF \n
+     * function template not used for uniformity with Calculate_Histogram_Trajs
+     */
+    template <
+    class Configuration_Policy,
+    template <class Configuration_type> class Read_Policy = Read_Homeostasis_Policy
+    >
+    class Calculate_Moran_Master_Equation {
+    private:
+
+        typedef typename Configuration_Policy::time_t time_type; // Item 42
+        typedef typename Configuration_Policy::population_t population_type;
+
+    public:
+
+        static const void implement() {
+
+            /* the master equation is that of the Moran processes */
+            BOOST_STATIC_ASSERT((boost::is_same<typename Configuration_Policy::category, configuration_categories::moran_category>::value));
+
+            /* set up policy object that reads input */
+            Read_Policy<Configuration_Policy> read_policy("main.in");
+
+            {
+                const Moran_Master_Equation<population_type> master_equation(read_policy.get_population(), read_policy.getUu(), read_policy.getSymmetry());
+
+                /* sample space of Statistics_Mutation */
+                const time_type time_span_histogram = read_policy.getTime_span_histogram();
+                const std::vector<time_type> sample_space = grid::make_uniform_grid(100, static_cast<time_type> (0), time_span_histogram);
+
+                /* mutation-time CDFs tracked by Statistics_Mutation */
+                exact_statistics::store_mutation_cdfs(master_equation, sample_space, read_policy.get_statistics_registry());
+
+                /* dump lifetime risk over time span of path to disk */
+                const Uniform_Time_Grid<time_type> time_grid = read_policy.getTime_grid();
+                exact_statistics::store_lifetime_risk(master_equation.lifetime_risk(time_grid.at(Node(time_grid.size() - 1))));
+
+            }
+
+            /* indicate that simulation has finished */
+            done();
+        }
+    };
+
+}
+
+#endif	/* MORAN_MASTER_EQUATION_H */
@@ -0,0 +1,278 @@
+#ifndef MULTILEVEL_SPLITTING_H
+#define	MULTILEVEL_SPLITTING_H
+
+#include <vector> // std::vector
+#include <cassert> // assert
+
+#include <boost/static_assert.hpp> // BOOST_STATIC_ASSERT
+#include <boost/type_traits/is_base_of.hpp> //  boost::is_base_of
+#include <boost/random/uniform_int_distribution.hpp> // boost::random::uniform_int_distribution
+
+#include <mutation_accumulation/probability/mean.h> // probability::Mean
+#include <mutation_accumulation/configuration/configuration/random_fwd.h> // monte_carlo::base_generator_type
+#include <mutation_accumulation/configuration/configuration/configuration_interface.h> // monte_carlo::Configuration_Interface
+#include <mutation_accumulation/configuration/configuration/node_listener.h> // monte_carlo::Node_Listener
+#include <mutation_accumulation/configuration/configuration/time_grid.h> // monte_carlo::Uniform_Time_Grid
+#include <mutation_accumulation/configuration/utilities/trial_summary.h> // monte_carlo::Trial_Summary
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace multilevel_splitting_detail {
+
+        /**
+         * listener that ignores node values \n
+         * a configuration that streams to it stores no path, so copying it (a snapshot) costs as much as copying its populations
+         */
+        template <class population_type>
+        class Discard_Nodes : public Node_Listener<population_type> {
+        public:
+
+            explicit Discard_Nodes() {
+
+            }
+
+            virtual void node_crossed(const Node &, const Population2D<population_type> &) {
+
+            }
+
+        };
+
+        /**
+         * state of a trajectory that has crossed a level: a copy of the configuration and of its first-passage data \n
+         * compiler-generated copy constructor is fine; configurations are not assignable
+         */
+        template <class Configuration_type>
+        struct Entrance_State {
+            Configuration_type configuration;
+            Trial_Summary<Configuration_type> summary;
+
+            explicit Entrance_State(const Configuration_type &configuration_) : configuration(configuration_), summary(configuration_) {
+
+            }
+        };
+
+        /**
+         * true if species level has arisen in some sub-population within the time span
+         */
+        template <class Configuration_type>
+        const bool level_reached(const Trial_Summary<Configuration_type> &summary, const int &level) {
+
+            const Spe spe(level);
+            return summary.mutation_occurred(spe) && summary.occurred_within_timeSpan(summary.mutation_time_whole(spe));
+        }
+
+    }
+
+    /**
+     * estimates from independent replicates of a multilevel splitting run: \n
+     * the probability that the last species arises within the time span (lifetime risk), \n
+     * and the probability that it has arisen by each node of the time grid (cumulative distribution of its mutation time) \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    class Splitting_Estimate {
+    private:
+
+        probability::Mean<double> _lifetime_risk;
+        std::vector<probability::Mean<double> > _cdf; // one per node
+        std::vector<probability::Mean<double> > _level_probabilities; // conditional probability of reaching each level from the previous one
+
+    public:
+
+        explicit Splitting_Estimate(const int &number_nodes, const int &number_levels)
+        : _cdf(number_nodes), _level_probabilities(number_levels) {
+
+        }
+
+        /**
+         * add the estimates of one replicate
+         */
+        void update(const double &lifetime_risk, const std::vector<double> &cdf, const std::vector<double> &level_probabilities) {
+
+            _lifetime_risk.update(lifetime_risk);
+            for (std::vector<probability::Mean<double> >::size_type node = 0; node < _cdf.size(); node++)
+                _cdf.at(node).update(cdf.at(node));
+            for (std::vector<probability::Mean<double> >::size_type level = 0; level < _level_probabilities.size(); level++)
+                _level_probabilities.at(level).update(level_probabilities.at(level));
+        }
+
+        const long long int number_replicates() const {
+
+            return _lifetime_risk.trials();
+        }
+
+        const double lifetime_risk() const {
+
+            return _lifetime_risk.value();
+        }
+
+        const double standard_error() const {
+
+            return _lifetime_risk.standard_error();
+        }
+
+        /**
+         * probability that the last species has arisen by node
+         */
+        const double cdf(const Node &node) const {
+
+            return _cdf.at(node.value()).value();
+        }
+
+        /**
+         * mean conditional probability of reaching species level + 1, given that species level has arisen
+         */
+        const double level_probability(const int &level) const {
+
+            return _level_probabilities.at(level).value();
+        }
+
+    };
+
+    /**
+     * estimate the probability that the last species arises within the time span by fixed-effort multilevel splitting \n
+     * level k is crossed when species k first arises (see MutationTimes); the last level is the last species \n
+     * \n
+     * a replicate runs effort trajectories per level: each starts from a copy of a state that crossed the previous level, \n
+     * chosen uniformly at random, and stops when it crosses the next level, ends, or extinguishes; \n
+     * the fraction that cross estimates the conditional probability of the level, \n
+     * and the product of these fractions is an unbiased estimate of the lifetime risk \n
+     * replicates are repeated until the standard error of their mean is error_probability times the mean, \n
+     * which is the precision at which Statistics_Lifetime_Risk stops \n
+     * \n
+     * configurations are used through Configuration_Interface only, so that every model can be split; \n
+     * the path of a trajectory is not stored, so snapshots are cheap copies \n
+     * function template not used for uniformity with Generate_Statistics
+     */
+    template <class Configuration_Policy>
+    class Multilevel_Splitting {
+    private:
+
+        typedef typename Configuration_Policy::time_t time_type; // Item 42
+        typedef typename Configuration_Policy::population_t population_type;
+        typedef multilevel_splitting_detail::Entrance_State<Configuration_Policy> State_type;
+
+        enum {
+            minimum_replicates = 10 // the enum hack (Item 2)
+        };
+
+    private:
+
+        /**
+         * run effort trajectories from the entrance states of a level and collect those that cross the next level \n
+         * configurations are copyable but not assignable, so states are collected into an empty vector rather than returned
+         */
+        static void run_level(
+                const std::vector<State_type> &entrance_states,
+                const int &next_level,
+                const int &effort,
+                base_generator_type &base_rand_gen,
+                std::vector<State_type> &crossed_states) {
+
+            boost::random::uniform_int_distribution<int> choose_state(0, entrance_states.size() - 1);
+
+            for (int ii = 0; ii < effort; ii++) {
+
+                /* restore snapshot */
+                State_type state(entrance_states.at(choose_state(base_rand_gen)));
+
+                /* generate trajectory until it crosses the next level or terminates */
+                while (!(state.summary.mutation_occurred(Spe(next_level)) || state.summary.end() || state.summary.extinguished())) {
+                    state.configuration.transition(base_rand_gen);
+                    state.summary.update(state.configuration);
+                }
+
+                if (multilevel_splitting_detail::level_reached(state.summary, next_level))
+                    crossed_states.push_back(state);
+            }
+        }
+
+        /**
+         * run one replicate and add its estimates
+         */
+        static void run_replicate(
+                const Configuration_Policy &configuration_root,
+                const Uniform_Time_Grid<time_type> &time_grid,
+                const int &effort,
+                base_generator_type &base_rand_gen,
+                Splitting_Estimate &estimate) {
+
+            const int number_levels = configuration_root.number_species() - 1;
+            const int last_level = number_levels;
+
+            std::vector<double> level_probabilities(number_levels, 0.0);
+            std::vector<double> cdf(time_grid.size(), 0.0);
+            double lifetime_risk = 1.0;
+
+            std::vector<State_type> states(1, State_type(configuration_root));
+            for (int level = 1; level <= last_level; level++) {
+
+                std::vector<State_type> crossed_states;
+                run_level(states, level, effort, base_rand_gen, crossed_states);
+                states.swap(crossed_states);
+
+                level_probabilities.at(level - 1) = static_cast<double> (states.size()) / static_cast<double> (effort);
+                lifetime_risk *= level_probabilities.at(level - 1);
+
+                if (states.empty()) break; // no trajectory survives to the next level
+            }
+
+            /* distribute the lifetime risk over the mutation times of the trajectories that crossed the last level */
+            if (!states.empty()) {
+                const double weight = lifetime_risk / static_cast<double> (states.size());
+                for (typename std::vector<State_type>::size_type ii = 0; ii < states.size(); ii++) {
+                    const time_type mutation_time = states.at(ii).summary.mutation_time_whole(Spe(last_level));
+                    for (int node = 0; node < time_grid.size(); node++)
+                        if (!(time_grid.at(Node(node)) < mutation_time)) cdf.at(node) += weight;
+                }
+            }
+
+            estimate.update(lifetime_risk, cdf, level_probabilities);
+        }
+
+    public:
+
+        /**
+         * seed generator explicitly \n
+         * configuration_init must not yet have made a transition
+         */
+        static const Splitting_Estimate implement(
+                const Configuration_Policy &configuration_init,
+                const Uniform_Time_Grid<time_type> &time_grid,
+                const int &effort,
+                const double &error_probability,
+                const unsigned int &seed) {
+
+            /* check policy type to supplement "duck typing" */
+            BOOST_STATIC_ASSERT((boost::is_base_of<Configuration_Interface<time_type, population_type>, Configuration_Policy>::value));
+
+            if (effort < 1 || configuration_init.number_species() < 2) {
+                std::cerr << "multilevel splitting needs a positive effort and at least two species" << std::endl;
+                assert(false);
+            }
+
+            /* PRNG */
+            base_generator_type base_rand_gen(seed);
+
+            /* snapshots of the root configuration, and of its descendants, store no path */
+            multilevel_splitting_detail::Discard_Nodes<population_type> discard_nodes;
+            Configuration_Policy configuration_root(configuration_init);
+            configuration_root.attach_node_listener(&discard_nodes);
+
+            Splitting_Estimate estimate(time_grid.size(), configuration_init.number_species() - 1);
+            const long long int maximum_replicates = static_cast<long long int> (1000000000000); // 1e12LL, as in Distribution_Statistics
+            do {
+                run_replicate(configuration_root, time_grid, effort, base_rand_gen, estimate);
+            } while ((estimate.number_replicates() < minimum_replicates ||
+                    !(estimate.lifetime_risk() > 0.0 && estimate.standard_error() <= error_probability * estimate.lifetime_risk())) &&
+                    estimate.number_replicates() < maximum_replicates);
+
+            return estimate;
+        }
+
+    };
+
+}
+
+#endif	/* MULTILEVEL_SPLITTING_H */
@@ -8,6 +8,7 @@
 #include <mutation_accumulation/configuration/configuration/random_fwd.h> // monte_carlo::base_generator_type
 #include <mutation_accumulation/configuration/configuration/configuration_interface.h> // monte_carlo::Configuration_Interface
 #include <mutation_accumulation/configuration/configuration/path_policy.h> // monte_carlo::Path_Policy_Base
+#include <mutation_accumulation/configuration/utilities/trial_summary.h> // monte_carlo::Trial_Summary
 #include <mutation_accumulation/simulation/files.h> // monte_carlo::open_file_for_output 
 #include <mutation_accumulation/configuration/configuration/branching_discrete.h> // monte_carlo::Branching_Discrete
 #include <mutation_accumulation/configuration/configuration/moran4.h> // monte_carlo::Moran4
@@ -38,12 +39,14 @@ namespace monte_carlo {
         }
 
         /** 
-         * print single trajectory at nodes and transitions
+         * print single trajectory at nodes and transitions \n
+         * decided sub-populations are frozen if freeze_decided is true, as in Generate_Statistics
          */
         template <class Configuration_Policy, class Path_Policy>
         void print_trajectory(
         const Configuration_Policy &configuration_init,
         const Path_Policy &path_policy,
+        const bool &freeze_decided,
         const std::string &file_name,
         base_generator_type &base_rand_gen) {
 
@@ -55,13 +58,16 @@ namespace monte_carlo {
             /* initialize the state of the stochastic process with a deterministic configuration\n
              * could initialize with a random configuration */
             Configuration_Policy configuration(configuration_init);
+            Trial_Summary<Configuration_Policy> summary(configuration);
 #ifdef PRINT_TRANSITIONS
             *ofstream_transitions_ptr << configuration << std::endl;
 #endif
 
             /* generate trajectory of the stochastic process */
-            while (!path_policy.terminate(configuration)) {
+            while (!path_policy.terminate(summary)) {
                 configuration.transition(base_rand_gen);
+                summary.update(configuration);
+                if (freeze_decided) path_policy.freeze_decided(summary, configuration);
 #ifdef PRINT_TRANSITIONS
                 *ofstream_transitions_ptr << configuration << std::endl;
 #endif
@@ -91,7 +97,7 @@ namespace monte_carlo {
             base_generator_type base_rand_gen(path_policy.successful_PRNG_states().at(trial)); // std::time(0) is a random seed
 
             std::string file_name = "successful_trajectory" + boost::lexical_cast<std::string > (trial) + ".dat";
-            print_trajectories_detail::print_trajectory(configuration_init, path_policy, file_name, base_rand_gen);
+            print_trajectories_detail::print_trajectory(configuration_init, path_policy, path_policy.successful_freeze_decided(), file_name, base_rand_gen);
 
         }
 
@@ -116,7 +122,7 @@ namespace monte_carlo {
         for (int trial = 0; trial < 10; trial++) {
 
             std::string file_name = "random_trajectory" + boost::lexical_cast<std::string > (trial) + ".dat";
-            print_trajectories_detail::print_trajectory(configuration_init, path_policy, file_name, base_rand_gen);
+            print_trajectories_detail::print_trajectory(configuration_init, path_policy, false, file_name, base_rand_gen);
 
         }
 
@@ -5,6 +5,7 @@
 #include <boost/type_traits/is_same.hpp>
 
 #include <mutation_accumulation/configuration/configuration/branching_discrete_diamond.h> 
+#include <mutation_accumulation/configuration/utilities/trial_summary.h> // monte_carlo::Trial_Summary
 
 /*************************************************************************/
 
@@ -43,9 +44,9 @@ namespace monte_carlo {
         }
 
         /* 
-         * print raw data
+         * print raw data of a trial from its summary
          */
-        virtual void print(const Configuration_Policy &configuration) = 0;
+        virtual void print(const Trial_Summary<Configuration_Policy> &summary) = 0;
 
     };
 
@@ -59,7 +60,7 @@ namespace monte_carlo {
         /* 
          * print raw data
          */
-        virtual void print(const Configuration_Policy &configuration) {
+        virtual void print(const Trial_Summary<Configuration_Policy> &) {
 
         }
 
@@ -86,9 +87,9 @@ namespace monte_carlo {
         /* 
          * print raw data
          */
-        virtual void print(const Configuration_Policy &configuration) {
+        virtual void print(const Trial_Summary<Configuration_Policy> &summary) {
 
-            *_ofstream_ptr << std::setw(20) << configuration.mutation_times(Pop(0), Spe(2)) << std::endl;
+            *_ofstream_ptr << std::setw(20) << summary.mutation_times(Pop(0), Spe(2)) << std::endl;
 
         }
 
@@ -122,12 +123,12 @@ namespace monte_carlo {
         /* 
          * print raw data
          */
-        virtual void print(const Configuration_Policy &configuration) {
+        virtual void print(const Trial_Summary<Configuration_Policy> &summary) {
 
-            const Spe last_species(configuration.number_species() - 1);                   
-            *_ofstream_ptr << std::setw(20) << configuration.mutation_times(Pop(0), last_species);
-            *_ofstream_ptr << std::setw(20) << configuration.a_yielded_ab(Pop(0));
-            *_ofstream_ptr << std::setw(20) << configuration.b_yielded_ab(Pop(0)) << std::endl;
+            const Spe last_species(summary.number_species() - 1);                   
+            *_ofstream_ptr << std::setw(20) << summary.mutation_times(Pop(0), last_species);
+            *_ofstream_ptr << std::setw(20) << summary.a_yielded_ab(Pop(0));
+            *_ofstream_ptr << std::setw(20) << summary.b_yielded_ab(Pop(0)) << std::endl;
         }
 
     };
@@ -3,7 +3,15 @@
 
 //#define DEBUG_READ_POLICY_H
 
+#include <string> // std::string
+#include <vector> // std::vector
+#include <fstream> // std::ifstream
+#include <iostream> // std::cerr
+#include <cassert> // assert
+
 #include <boost/shared_ptr.hpp> // boost::shared_ptr
+#include <boost/algorithm/string.hpp> // boost::split, boost::trim
+#include <boost/lexical_cast.hpp> // boost::lexical_cast
 #include <mutation_accumulation/parameters/parameters_fwd.h> // Symmetry, etc
 
 #include <boost/type_traits/is_base_of.hpp>
@@ -11,8 +19,10 @@
 #include <mutation_accumulation/configuration/configuration/population2D.h>
 #include <mutation_accumulation/configuration/configuration/mutation_rates.h> // monte_carlo::MutationRates
 #include <mutation_accumulation/configuration/configuration/time_grid.h> // monte_carlo::Uniform_Time_Grid
+#include <mutation_accumulation/configuration/configuration/branching_discrete.h> // monte_carlo::Branching_Discrete
 
 #include <mutation_accumulation/utility/strings.h> // strings::parse_scalar, etc
+#include <mutation_accumulation/statistics/statistics/statistics_registry.h> // monte_carlo::read_statistics_registry_option
 
 /*************************************************************************/
 
@@ -21,6 +31,49 @@
  */
 namespace monte_carlo {
 
+    namespace read_policy_detail {
+
+        /**
+         * read optional trailing lines of an input file, e.g.\n
+         * track_spe = 3 \n
+         * sub_pop_threads = 8 \n
+         * lines that select tracked cells are those of read_statistics_registry; \n
+         * sub_pop_threads updates the sub-populations of each trajectory on that many threads, \n
+         * each sub-population from its own random stream (see Branching_Discrete::update_sub_pops_in_parallel); \n
+         * if absent, sub-populations share a single random stream and are updated in turn
+         */
+        inline void read_trailing_options(std::ifstream &ifs, Statistics_Registry &registry, int &sub_pop_threads) {
+
+            registry = Statistics_Registry();
+            sub_pop_threads = 0;
+
+            std::string text_line;
+            while (std::getline(ifs, text_line)) {
+
+                if (boost::trim_copy(text_line).empty()) continue;
+
+                std::vector<std::string> tokens;
+                boost::split(tokens, text_line, boost::is_any_of("="));
+                if (tokens.size() != 2) {
+                    std::cerr << "cannot parse line of input file: " << text_line << std::endl;
+                    assert(false);
+                }
+
+                const std::string key = boost::trim_copy(tokens.at(0));
+                const std::string values = boost::trim_copy(tokens.at(1));
+
+                if (key == "sub_pop_threads") {
+                    sub_pop_threads = boost::lexical_cast<int> (values);
+                    assert(sub_pop_threads >= 0);
+                } else if (!read_statistics_registry_option(registry, key, values)) {
+                    std::cerr << "unknown key in input file: " << key << std::endl;
+                    assert(false);
+                }
+            }
+        }
+
+    }
+
     /** 
      * interface for reading in parameter values
      */
@@ -99,6 +152,16 @@ namespace monte_carlo {
          */
         virtual const divisor_t get_observer_divisor() const = 0;
 
+        /**
+         * get cells of histogram matrices to track 
+         */
+        virtual const Statistics_Registry get_statistics_registry() const = 0;
+
+        /**
+         * get number of threads that update the sub-populations of a trajectory; zero if they share a single random stream
+         */
+        virtual const int get_sub_pop_threads() const = 0;
+
     };
 
     /** 
@@ -121,6 +184,8 @@ namespace monte_carlo {
         time_type _time_span_histogram;
         error_type _error_probability;
         divisor_type _observer_divisor;
+        Statistics_Registry _statistics_registry;
+        int _sub_pop_threads;
 
 
     public:
@@ -173,6 +238,9 @@ namespace monte_carlo {
             /* write histogram log data every observer_divisor times observer is notified */
             _observer_divisor = strings::parse_scalar<divisor_type > (*ifstream_ptr);
 
+            /* read in optional selection of histogram cells to track, and number of threads per trajectory */
+            read_policy_detail::read_trailing_options(*ifstream_ptr, _statistics_registry, _sub_pop_threads);
+
 
         }
 
@@ -235,6 +303,20 @@ namespace monte_carlo {
             return _observer_divisor;
         }
 
+        /**
+         * get cells of histogram matrices to track 
+         */
+        virtual const Statistics_Registry get_statistics_registry() const {
+            return _statistics_registry;
+        }
+
+        /**
+         * get number of threads that update the sub-populations of a trajectory
+         */
+        virtual const int get_sub_pop_threads() const {
+            return _sub_pop_threads;
+        }
+
     };
 
     /** 
@@ -258,6 +340,8 @@ namespace monte_carlo {
         time_type _time_span_histogram;
         error_type _error_probability;
         divisor_type _observer_divisor;
+        Statistics_Registry _statistics_registry;
+        int _sub_pop_threads;
         
 
 
@@ -320,6 +404,9 @@ namespace monte_carlo {
             /* write histogram log data every observer_divisor times observer is notified */
             _observer_divisor = strings::parse_scalar<divisor_type > (*ifstream_ptr);
 
+            /* read in optional selection of histogram cells to track, and number of threads per trajectory */
+            read_policy_detail::read_trailing_options(*ifstream_ptr, _statistics_registry, _sub_pop_threads);
+
 
         }
 
@@ -382,8 +469,96 @@ namespace monte_carlo {
             return _observer_divisor;
         }
 
+        /**
+         * get cells of histogram matrices to track 
+         */
+        virtual const Statistics_Registry get_statistics_registry() const {
+            return _statistics_registry;
+        }
+
+        /**
+         * get number of threads that update the sub-populations of a trajectory
+         */
+        virtual const int get_sub_pop_threads() const {
+            return _sub_pop_threads;
+        }
+
+    };
+
+    /**
+     * parameters of another read policy, restricted to a single sub-population \n
+     * every cell of the histogram matrices is tracked \n
+     * lets drivers simulate one sub-population of a population whose sub-populations evolve independently \n
+     * holds a reference: read_policy must outlive this object
+     */
+    template <class Configuration_Policy>
+    class Read_Sub_Population_Policy : public Read_Policy_Base<Configuration_Policy > {
+    private:
+        typedef Read_Policy_Base<Configuration_Policy> base_type;
+        typedef typename base_type::time_t time_type; // Item 42
+        typedef typename base_type::population_t population_type;
+        typedef typename base_type::Population2D_t Population2D_type;
+        typedef typename base_type::Uniform_Time_Grid_t Uniform_Time_Grid_type;
+        typedef typename base_type::error_t error_type; // item 43 "Know how to access names in templatized base classes" in "Effective C++: 55 Specific Ways to Improve Your Programs and Designs"
+        typedef typename base_type::divisor_t divisor_type;
+
+        const base_type &_read_policy;
+        Population2D_type _population2D;
+
+    public:
+
+        /**
+         * custom constructor
+         */
+        explicit Read_Sub_Population_Policy(const base_type &read_policy, const Pop &pop) : _read_policy(read_policy) {
+
+            const Population2D_type population2D = read_policy.get_population();
+            _population2D = Population2D_type(1, population2D.number_species());
+            for (int spe = 0; spe < population2D.number_species(); spe++)
+                _population2D.at(0, spe) = population2D.at(pop.value(), spe);
+        }
+
+        virtual const Population2D_type get_population() const {
+            return _population2D;
+        }
+
+        virtual const SymmetricRenewal get_SymmetricRenewal() const {
+            return _read_policy.get_SymmetricRenewal();
+        }
+
+        virtual const MutationRates getUu() const {
+            return _read_policy.getUu();
+        }
+
+        virtual const Symmetry getSymmetry() const {
+            return _read_policy.getSymmetry();
+        }
+
+        virtual const Uniform_Time_Grid_type getTime_grid() const {
+            return _read_policy.getTime_grid();
+        }
+
+        virtual const time_type getTime_span_histogram() const {
+            return _read_policy.getTime_span_histogram();
+        }
+
+        virtual const error_type get_error_prob() const {
+            return _read_policy.get_error_prob();
+        }
+
+        virtual const divisor_type get_observer_divisor() const {
+            return _read_policy.get_observer_divisor();
+        }
+
+        virtual const Statistics_Registry get_statistics_registry() const {
+            return Statistics_Registry();
+        }
+
+        virtual const int get_sub_pop_threads() const {
+            return _read_policy.get_sub_pop_threads();
+        }
+
     };
 }
 
 #endif	/* READ_POLICY_H */
-
@@ -0,0 +1,202 @@
+#ifndef RESULT_CACHE_H
+#define	RESULT_CACHE_H
+
+#include <string> // std::string
+#include <vector> // std::vector
+#include <sstream> // std::ostringstream
+#include <fstream> // std::ifstream, std::ofstream
+#include <iostream> // std::cerr
+#include <iomanip> // std::setprecision
+#include <limits> // std::numeric_limits
+#include <cstdio> // std::rename
+#include <cassert> // assert
+
+#include <boost/cstdint.hpp> // boost::uint64_t
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * 64-bit FNV-1a hash of a string
+     */
+    inline const boost::uint64_t fnv1a_64(const std::string &text) {
+
+        boost::uint64_t hash = 14695981039346656037ULL;
+        for (std::string::size_type ii = 0; ii < text.size(); ii++) {
+            hash ^= static_cast<unsigned char> (text.at(ii));
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /**
+     * canonical text of the parameters that determine a set of statistics, e.g. \n
+     * model=...;N0=1000;uu=0.001,0.002;ss=0.5;time_span=80; \n
+     * parameters are added in a fixed order, and floating-point values are written with enough digits to be recovered exactly, \n
+     * so that equal parameters give equal keys \n
+     * parameters that only control convergence (e.g. error_probability) or output must not be added: \n
+     * cached statistics are then reused, or topped up, when the error target changes \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    class Cache_Key {
+    private:
+
+        std::string _text;
+
+    public:
+
+        explicit Cache_Key() {
+
+        }
+
+        /**
+         * append a named scalar
+         */
+        template <class value_type>
+        void add(const std::string &name, const value_type &value) {
+
+            std::ostringstream oss;
+            oss << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+            oss << name << "=" << value << ";";
+            _text += oss.str();
+        }
+
+        /**
+         * append a named list of scalars
+         */
+        template <class value_type>
+        void add(const std::string &name, const std::vector<value_type> &values) {
+
+            std::ostringstream oss;
+            oss << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+            oss << name << "=";
+            for (typename std::vector<value_type>::size_type ii = 0; ii < values.size(); ii++)
+                oss << (ii > 0 ? "," : "") << values.at(ii);
+            oss << ";";
+            _text += oss.str();
+        }
+
+        const std::string text() const {
+
+            return _text;
+        }
+
+        /**
+         * name of cache file: hexadecimal FNV-1a hash of text
+         */
+        const std::string file_name() const {
+
+            std::ostringstream oss;
+            oss << std::hex << std::setw(16) << std::setfill('0') << fnv1a_64(_text) << ".cache";
+            return oss.str();
+        }
+
+    };
+
+    /**
+     * on-disk store of the histogram frequencies of converged statistics, one file per Cache_Key, in a given directory \n
+     * a file holds the key text (to detect hash collisions), the number of trials, and the frequencies written by \n
+     * Distribution_Statistics::write_frequencies(..) \n
+     * a cache constructed without a directory is disabled: nothing is loaded or saved \n
+     * \n
+     * files are written to a temporary file that is then renamed, so that an interrupted run leaves the previous entry intact; \n
+     * concurrent runs with equal keys are not supported \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    class Result_Cache {
+    private:
+
+        std::string _directory;
+
+    private:
+
+        const std::string path(const Cache_Key &key) const {
+
+            return _directory + "/" + key.file_name();
+        }
+
+    public:
+
+        /**
+         * disabled cache
+         */
+        explicit Result_Cache() {
+
+        }
+
+        /**
+         * cache in an existing directory
+         */
+        explicit Result_Cache(const std::string &directory_) : _directory(directory_) {
+
+        }
+
+        const bool enabled() const {
+
+            return !_directory.empty();
+        }
+
+        /**
+         * merge cached frequencies into statistics, which should hold no samples \n
+         * returns the number of cached trials (zero if there is no entry for key)
+         */
+        template <class Statistics_type>
+        const long long int load(const Cache_Key &key, Statistics_type &statistics) const {
+
+            if (!enabled()) return 0;
+
+            std::ifstream ifs(path(key).c_str());
+            if (!ifs.is_open()) return 0;
+
+            std::string key_text;
+            std::getline(ifs, key_text);
+            if (key_text != key.text()) {
+                std::cerr << "hash collision in result cache; ignoring " << path(key) << std::endl;
+                return 0;
+            }
+
+            long long int number_trials;
+            ifs >> number_trials;
+            if (!ifs) {
+                std::cerr << "cannot read " << path(key) << std::endl;
+                assert(false);
+            }
+
+            statistics.merge_frequencies(ifs);
+
+            return number_trials;
+        }
+
+        /**
+         * store frequencies of statistics, replacing any previous entry for key
+         */
+        template <class Statistics_type>
+        void save(const Cache_Key &key, const Statistics_type &statistics) const {
+
+            if (!enabled()) return;
+
+            const std::string temporary_path = path(key) + ".tmp";
+            {
+                std::ofstream ofs(temporary_path.c_str());
+                if (!ofs.is_open()) {
+                    std::cerr << "cannot open " << temporary_path << std::endl;
+                    assert(false);
+                }
+
+                ofs << key.text() << std::endl;
+                ofs << statistics.number_trials() << std::endl;
+                statistics.write_frequencies(ofs);
+            }
+
+            if (std::rename(temporary_path.c_str(), path(key).c_str()) != 0) {
+                std::cerr << "cannot rename " << temporary_path << std::endl;
+                assert(false);
+            }
+        }
+
+    };
+
+}
+
+#endif	/* RESULT_CACHE_H */
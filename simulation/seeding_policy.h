@@ -0,0 +1,113 @@
+#ifndef SEEDING_POLICY_H
+#define	SEEDING_POLICY_H
+
+#include <boost/cstdint.hpp> // boost::uint64_t, boost::uint32_t
+#include <boost/random/seed_seq.hpp> // boost::random::seed_seq
+
+#include <mutation_accumulation/configuration/configuration/random_fwd.h> // monte_carlo::base_generator_type
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace seeding_detail {
+
+        /**
+         * SplitMix64 mixing function (Steele, Lea and Flood 2014)\n
+         * maps consecutive integers to well-separated 64-bit values
+         */
+        inline const boost::uint64_t splitmix64(boost::uint64_t xx) {
+
+            xx += 0x9E3779B97F4A7C15ULL;
+            xx = (xx ^ (xx >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            xx = (xx ^ (xx >> 27)) * 0x94D049BB133111EBULL;
+            return xx ^ (xx >> 31);
+        }
+
+    }
+
+    /**
+     * stream index of a family of random streams labelled by key: the SplitMix64 sequence (Steele, Lea and Flood 2014) \n
+     * starting from a state that depends only on (key, index)\n
+     * unlike base_generator_type, it costs nothing to seed, \n
+     * so a short-lived stream can be started for every unit of work that must not depend on the order in which units are done \n
+     * models a uniform random number generator; compiler-generated copy constructor and assignment operator are fine
+     */
+    class SplitMix64_Stream {
+    private:
+
+        boost::uint64_t _state;
+
+    public:
+
+        typedef boost::uint64_t result_type;
+
+        explicit SplitMix64_Stream(const boost::uint64_t &key, const long long int &index)
+        : _state(seeding_detail::splitmix64(key ^ static_cast<boost::uint64_t> (index))) {
+
+        }
+
+        static const result_type min() {
+
+            return 0;
+        }
+
+        static const result_type max() {
+
+            return ~static_cast<result_type> (0);
+        }
+
+        /**
+         * splitmix64 advances the state by a fixed increment before mixing it
+         */
+        const result_type operator()() {
+
+            const result_type value = seeding_detail::splitmix64(_state);
+            _state += 0x9E3779B97F4A7C15ULL;
+            return value;
+        }
+    };
+
+    /**
+     * rules dictating how the generator is seeded at the start of each trial of Generate_Statistics\n
+     * using independent classes rather than a hierarchy of classes because I want to invoke without instantiation
+     */
+
+    /**
+     * trials draw successive numbers from a single stream seeded once per run\n
+     * randomness of trial k depends on how many numbers earlier trials consumed
+     */
+    struct Continuous_Stream {
+
+        static void start_trial(base_generator_type &, const unsigned int &, const long long int &) {
+
+        }
+    };
+
+    /**
+     * trial k draws from its own stream, which depends only on (master_seed, k)\n
+     * runs that share a master seed therefore drive trial k of every parameter variant with identical random numbers \n
+     * (common random numbers), which correlates their estimates and reduces the variance of differences and ratios \n
+     * \n
+     * stream of a trial is seeded with 128 bits derived by SplitMix64, so streams of distinct trials do not collide
+     */
+    struct Per_Trial_Streams {
+
+        static void start_trial(base_generator_type &base_rand_gen, const unsigned int &master_seed, const long long int &trial) {
+
+            const boost::uint64_t key = seeding_detail::splitmix64(static_cast<boost::uint64_t> (master_seed));
+            const boost::uint64_t word0 = seeding_detail::splitmix64(key ^ static_cast<boost::uint64_t> (trial));
+            const boost::uint64_t word1 = seeding_detail::splitmix64(word0);
+
+            const boost::uint32_t words[4] = {
+                static_cast<boost::uint32_t> (word0), static_cast<boost::uint32_t> (word0 >> 32),
+                static_cast<boost::uint32_t> (word1), static_cast<boost::uint32_t> (word1 >> 32)
+            };
+            boost::random::seed_seq seed_sequence(words, words + 4);
+            base_rand_gen.seed(seed_sequence);
+        }
+    };
+
+}
+
+#endif	/* SEEDING_POLICY_H */
@@ -0,0 +1,266 @@
+#ifndef SWEEP_SCHEDULER_H
+#define	SWEEP_SCHEDULER_H
+
+#include <vector> // std::vector
+#include <string> // std::string
+#include <fstream> // std::ifstream
+#include <iostream> // std::cerr
+#include <algorithm> // std::min, std::max
+#include <cassert> // assert
+
+#include <thread> // std::thread
+#include <atomic> // std::atomic
+
+#include <boost/algorithm/string.hpp> // boost::split, boost::trim
+#include <boost/lexical_cast.hpp> // boost::lexical_cast
+
+#include "result_cache.h" // monte_carlo::Result_Cache
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * caps the number of threads used by a parameter sweep\n
+     * grid points each run on a single thread, so the number of concurrent grid points is the thread cap \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    class Thread_Budget {
+    private:
+
+        int _max_threads;
+
+    public:
+
+        /**
+         * use one thread per hardware thread
+         */
+        explicit Thread_Budget() : _max_threads(std::max(1u, std::thread::hardware_concurrency())) {
+
+        }
+
+        /**
+         * use at most max_threads threads
+         */
+        explicit Thread_Budget(const int &max_threads_) : _max_threads(max_threads_) {
+
+            assert(_max_threads > 0);
+        }
+
+        /**
+         * number of worker threads to use for number_tasks independent grid points
+         */
+        const int number_workers(const int &number_tasks) const {
+
+            return std::max(1, std::min(_max_threads, number_tasks));
+        }
+
+    };
+
+    /**
+     * options of a parameter sweep that may be set by optional trailing lines of an input file \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    class Sweep_Options {
+    private:
+
+        Thread_Budget _thread_budget;
+        bool _coupled;
+        Result_Cache _cache;
+        int _refinements;
+        double _tilt;
+        int _splitting_effort;
+        bool _sensitivities;
+        bool _conditional;
+
+    public:
+
+        /**
+         * one thread per hardware thread; grid points use independent random numbers; no cache; no refinement; no tilt; no splitting; no sensitivities; \n
+         * no conditional Monte Carlo
+         */
+        explicit Sweep_Options() : _thread_budget(), _coupled(false), _cache(), _refinements(0), _tilt(1.0), _splitting_effort(0), _sensitivities(false), _conditional(false) {
+
+        }
+
+        explicit Sweep_Options(const Thread_Budget &thread_budget_, const bool &coupled_, const Result_Cache &cache_, const int &refinements_, const double &tilt_, const int &splitting_effort_, const bool &sensitivities_, const bool &conditional_)
+        : _thread_budget(thread_budget_), _coupled(coupled_), _cache(cache_), _refinements(refinements_), _tilt(tilt_), _splitting_effort(splitting_effort_), _sensitivities(sensitivities_), _conditional(conditional_) {
+
+            assert(_refinements >= 0);
+            assert(_tilt > 0.0);
+            assert(_splitting_effort >= 0);
+        }
+
+        const Thread_Budget thread_budget() const {
+
+            return _thread_budget;
+        }
+
+        /**
+         * whether trial k of every grid point is driven by the same random stream (common random numbers)
+         */
+        const bool coupled() const {
+
+            return _coupled;
+        }
+
+        /**
+         * cache of statistics of earlier runs
+         */
+        const Result_Cache cache() const {
+
+            return _cache;
+        }
+
+        /**
+         * maximum number of parameter values that may be added to the initial grid
+         */
+        const int refinements() const {
+
+            return _refinements;
+        }
+
+        /**
+         * factor by which mutation rates are multiplied to simulate paths (importance sampling); one means plain Monte Carlo
+         */
+        const double tilt() const {
+
+            return _tilt;
+        }
+
+        /**
+         * number of trajectories per level of multilevel splitting; zero means plain Monte Carlo
+         */
+        const int splitting_effort() const {
+
+            return _splitting_effort;
+        }
+
+        /**
+         * whether derivatives of results with respect to mutation rates and symmetry are estimated from the same trials
+         */
+        const bool sensitivities() const {
+
+            return _sensitivities;
+        }
+
+        /**
+         * whether trajectories stop at the penultimate species, and the last mutation step is integrated out (conditional Monte Carlo)
+         */
+        const bool conditional() const {
+
+            return _conditional;
+        }
+
+    };
+
+    /**
+     * read optional trailing lines of an input file, e.g.\n
+     * threads = 8 \n
+     * coupled = 1 \n
+     * cache = results \n
+     * refine = 10 \n
+     * tilt = 20 \n
+     * split = 1000 \n
+     * sensitivities = 1 \n
+     * conditional = 1 \n
+     * threads caps the number of threads; if absent, one thread per hardware thread is used \n
+     * coupled = 1 drives all grid points with common random numbers; if absent, grid points are independent \n
+     * cache names an existing directory in which statistics are cached across runs; if absent, nothing is cached \n
+     * refine caps the number of parameter values added where results change fastest; if absent, the grid is not refined \n
+     * tilt multiplies mutation rates during simulation, and weights paths by their likelihood ratios; if absent, rates are not tilted \n
+     * split runs that many trajectories per level of multilevel splitting; if absent, trajectories are not split \n
+     * sensitivities = 1 estimates derivatives with respect to mutation rates and symmetry by the likelihood-ratio method; if absent, they are not \n
+     * conditional = 1 stops trajectories once the penultimate species has arisen, and averages the probability that the last one arises \n
+     * in the rest of the time span; if absent, trajectories are simulated to the end \n
+     * threads, coupled and refine only apply to sweeps; an input file for a single parameter set (sweep = false) may not contain them
+     */
+    inline const Sweep_Options read_sweep_options(std::ifstream &ifs, const bool &sweep = true) {
+
+        Thread_Budget thread_budget;
+        bool coupled = false;
+        Result_Cache cache;
+        int refinements = 0;
+        double tilt = 1.0;
+        int splitting_effort = 0;
+        bool sensitivities = false;
+        bool conditional = false;
+
+        std::string text_line;
+        while (std::getline(ifs, text_line)) {
+
+            if (boost::trim_copy(text_line).empty()) continue;
+
+            std::vector<std::string> tokens;
+            boost::split(tokens, text_line, boost::is_any_of("="));
+            if (tokens.size() != 2) {
+                std::cerr << "cannot parse line of input file: " << text_line << std::endl;
+                assert(false);
+            }
+
+            const std::string key = boost::trim_copy(tokens.at(0));
+            const std::string value = boost::trim_copy(tokens.at(1));
+            if (!sweep && ((key == "threads") || (key == "coupled") || (key == "refine"))) {
+                std::cerr << "sweep option " << key << " does not apply to a single parameter set" << std::endl;
+                assert(false);
+            }
+
+            if (key == "threads")
+                thread_budget = Thread_Budget(boost::lexical_cast<int> (value));
+            else if (key == "coupled")
+                coupled = (boost::lexical_cast<int> (value) != 0);
+            else if (key == "cache")
+                cache = Result_Cache(value);
+            else if (key == "refine")
+                refinements = boost::lexical_cast<int> (value);
+            else if (key == "tilt")
+                tilt = boost::lexical_cast<double> (value);
+            else if (key == "split")
+                splitting_effort = boost::lexical_cast<int> (value);
+            else if (key == "sensitivities")
+                sensitivities = (boost::lexical_cast<int> (value) != 0);
+            else if (key == "conditional")
+                conditional = (boost::lexical_cast<int> (value) != 0);
+            else {
+                std::cerr << "unknown sweep option: " << key << std::endl;
+                assert(false);
+            }
+        }
+
+        return Sweep_Options(thread_budget, coupled, cache, refinements, tilt, splitting_effort, sensitivities, conditional);
+    }
+
+    /**
+     * run work(task) for every task on a pool of worker threads\n
+     * idle workers claim the next unclaimed task, so expensive and cheap tasks are balanced dynamically; \n
+     * tasks should be ordered most expensive first, so that no expensive task starts last \n
+     * \n
+     * work is shared by all workers and must be safe to call concurrently
+     */
+    template <class Task, class Work>
+    void run_sweep(const std::vector<Task> &tasks, const Thread_Budget &thread_budget, Work &work) {
+
+        std::atomic<int> next_task(0);
+
+        /* worker body: claim tasks until none remain */
+        struct Worker {
+
+            static void run(const std::vector<Task> *tasks, std::atomic<int> *next_task, Work *work) {
+
+                for (int ii = (*next_task)++; ii < static_cast<int> (tasks->size()); ii = (*next_task)++)
+                    (*work)(tasks->at(ii));
+            }
+        };
+
+        std::vector<std::thread> workers;
+        const int number_workers = thread_budget.number_workers(tasks.size());
+        for (int ww = 0; ww < number_workers; ww++)
+            workers.push_back(std::thread(&Worker::run, &tasks, &next_task, &work));
+
+        for (std::vector<std::thread>::size_type ww = 0; ww < workers.size(); ww++)
+            workers.at(ww).join();
+    }
+
+}
+
+#endif	/* SWEEP_SCHEDULER_H */
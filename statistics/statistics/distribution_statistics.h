@@ -9,6 +9,7 @@
 #include <mutation_accumulation/probability/histogram.h> // probability::SampleSpace_Probability
 
 #include "statistics_gatherer.h" // monte_carlo::Statistics_Gatherer
+#include "statistics_registry.h" // monte_carlo::Statistics_Registry
 
 /*************************************************************************/
 
@@ -17,6 +18,8 @@ namespace monte_carlo {
     /**
      * each sub-population is endowed with a matrix of histograms\n
      * should generalize matrix to array of arbitrary dimensionality\n
+     * cells that are not tracked by the Statistics_Registry hold null pointers \n
+     * (they are never allocated, updated, or stored, and their results are empty)\n
      */
     template<class Histogram_type, class Configuration_type>
     class Distribution_Statistics : public Statistics_Gatherer<Configuration_type, probability::SampleSpace_Probability<typename Histogram_type::sample_t> > {
@@ -52,6 +55,8 @@ namespace monte_carlo {
         const int _jj_per_pop_to_observe; // which row of histogram matrix to monitor in sub-population _pop_to_observe 
         const int _kk_per_pop_to_observe; // which col of histogram matrix to monitor in sub-population _pop_to_observe 
 
+        const Statistics_Registry _registry; // which cells to track
+
     private:
 
         /** 
@@ -59,6 +64,8 @@ namespace monte_carlo {
          */
         const SampleSpace_Probability_type fetch_sampleSpace_probability(const Histogram_ptr_type &histogram_ptr) const {
 
+            if (!histogram_ptr) return SampleSpace_Probability_type(); // untracked cell
+
             const std::vector<sample_type> ss = histogram_ptr->get_sample_space();
             const std::vector<double> pp = histogram_ptr->get_probability();
 
@@ -66,12 +73,49 @@ namespace monte_carlo {
 
         }
 
+        /**
+         * write frequencies of a single histogram (untracked cells are skipped)
+         */
+        void write_frequencies(std::ostream &os, const Histogram_ptr_type &histogram_ptr) const {
+
+            if (!histogram_ptr) return;
+
+            const std::vector<typename Histogram_type::frequency_t> &frequencies = histogram_ptr->get_frequencies();
+            os << histogram_ptr->get_number_trials();
+            for (int ii = 0; ii < frequencies.size(); ii++)
+                os << " " << frequencies.at(ii);
+            os << std::endl;
+        }
+
+        /**
+         * merge frequencies of a single histogram (untracked cells are skipped)
+         */
+        void merge_frequencies(std::istream &is, const Histogram_ptr_type &histogram_ptr) {
+
+            if (!histogram_ptr) return;
+
+            typename Histogram_type::number_trials_t number_trials;
+            std::vector<typename Histogram_type::frequency_t> frequencies(histogram_ptr->get_sample_space().size());
+            is >> number_trials;
+            for (int ii = 0; ii < frequencies.size(); ii++)
+                is >> frequencies.at(ii);
+
+            if (!is) {
+                std::cerr << "cannot read frequencies of histogram" << std::endl;
+                assert(false);
+            }
+
+            histogram_ptr->merge_frequencies(frequencies, number_trials);
+        }
+
 
     protected:
 
         /**
          * constructor \n
-         * base-class default ctor called by compiler
+         * base-class default ctor called by compiler \n
+         * file_prefix is prepended to histogram filenames, so that several gatherers can share a directory \n
+         * registry selects the cells to track; the observed cell is always tracked
          */
         explicit Distribution_Statistics(
                 const Number_Pop &number_pop,
@@ -86,14 +130,17 @@ namespace monte_carlo {
                 const int &kk_per_pop_to_observe,
                 const int &observer_divisor,
                 const std::string &label_for_dim1_per_pop,
-                const std::string &label_for_dim2_per_pop)
+                const std::string &label_for_dim2_per_pop,
+                const std::string &file_prefix = "",
+                const Statistics_Registry &registry = Statistics_Registry())
         :
         _histograms(array3D_histograms_type(number_pop.value(), dim1_per_pop, dim2_per_pop)),
         _histograms_whole(array2D_histograms_type(dim0_whole, dim1_whole)),
         _error_probability(error_probability),
         _pop_to_observe(pop_to_observe.value()),
         _jj_per_pop_to_observe(jj_per_pop_to_observe),
-        _kk_per_pop_to_observe(kk_per_pop_to_observe) {
+        _kk_per_pop_to_observe(kk_per_pop_to_observe),
+        _registry(registry) {
 
             /* check template parameter types to supplement "duck typing" */
             BOOST_STATIC_ASSERT((boost::is_base_of<probability::Histogram<sample_type>, Histogram_type>::value));
@@ -103,7 +150,9 @@ namespace monte_carlo {
                 for (int jj = 0; jj < dim1_per_pop; jj++)
                     for (int kk = 0; kk < dim2_per_pop; kk++) {
 
-                        std::string filename =
+                        if (!tracked(Pop(pop), jj, kk)) continue;
+
+                        std::string filename = file_prefix +
                                 "histogram__pop" + boost::lexical_cast<std::string > (pop) +
                                 "__" + label_for_dim1_per_pop + boost::lexical_cast<std::string > (jj) +
                                 "__" + label_for_dim2_per_pop + boost::lexical_cast<std::string > (kk) +
@@ -117,7 +166,9 @@ namespace monte_carlo {
                 for (int ii = 0; ii < dim0_whole; ii++)
                     for (int jj = 0; jj < dim1_whole; jj++) {
 
-                        std::string filename =
+                        if (!tracked_whole(ii, jj)) continue;
+
+                        std::string filename = file_prefix +
                                 "histogramWhole__" +
                                 label_for_dim1_per_pop +
                                 boost::lexical_cast<std::string > (ii) +
@@ -129,7 +180,7 @@ namespace monte_carlo {
 
             /* create histogram observer */
             {
-                std::string filename =
+                std::string filename = file_prefix +
                         "histogram__pop" + boost::lexical_cast<std::string > (_pop_to_observe) +
                         "__" + label_for_dim1_per_pop + boost::lexical_cast<std::string > (_jj_per_pop_to_observe) +
                         "__" + label_for_dim2_per_pop + boost::lexical_cast<std::string > (_kk_per_pop_to_observe) +
@@ -139,21 +190,42 @@ namespace monte_carlo {
 
         }
 
+        /**
+         * true if sub-population cell is tracked \n
+         * derived classes may use this to avoid computing samples that would be discarded
+         */
+        const bool tracked(const Pop &pop, const int &jj, const int &kk) const {
+
+            const bool observed = (pop.value() == _pop_to_observe) && (jj == _jj_per_pop_to_observe) && (kk == _kk_per_pop_to_observe);
+
+            return observed || _registry.tracked(pop.value(), jj, kk);
+        }
+
+        /**
+         * true if whole-population cell is tracked
+         */
+        const bool tracked_whole(const int &ii, const int &jj) const {
+
+            return _registry.tracked_whole(ii, jj);
+        }
+
         /** 
-         * update sub-population histogram matrices
+         * update sub-population histogram matrices (untracked cells are skipped)
          */
         void update_histograms(const Pop &pop, const int &jj, const int &kk, const sample_type &sample) {
 
-            _histograms.at(pop.value(), jj, kk)->update(sample);
+            const Histogram_ptr_type &histogram_ptr = _histograms.at(pop.value(), jj, kk);
+            if (histogram_ptr) histogram_ptr->update(sample);
 
         }
 
         /** 
-         * update whole-population histogram matrix
+         * update whole-population histogram matrix (untracked cells are skipped)
          */
         void update_histograms_whole(const int &ii, const int &jj, const sample_type &sample) {
 
-            _histograms_whole.at(ii, jj)->update(sample);
+            const Histogram_ptr_type &histogram_ptr = _histograms_whole.at(ii, jj);
+            if (histogram_ptr) histogram_ptr->update(sample);
 
         }
 
@@ -182,6 +254,45 @@ namespace monte_carlo {
 
         }
 
+        /**
+         * number of trials sampled by observed histogram
+         */
+        const long long int number_trials() const {
+
+            return _histograms.at(_pop_to_observe, _jj_per_pop_to_observe, _kk_per_pop_to_observe)->get_number_trials();
+        }
+
+        /**
+         * write frequencies of tracked histograms, one histogram per line, preceded by its number of trials \n
+         * sub-population histograms are written before whole-population histograms
+         */
+        void write_frequencies(std::ostream &os) const {
+
+            for (int pop = 0; pop < _histograms.get_dim0(); pop++)
+                for (int jj = 0; jj < _histograms.get_dim1(); jj++)
+                    for (int kk = 0; kk < _histograms.get_dim2(); kk++)
+                        write_frequencies(os, _histograms.at(pop, jj, kk));
+
+            for (int ii = 0; ii < _histograms_whole.get_dim0(); ii++)
+                for (int jj = 0; jj < _histograms_whole.get_dim1(); jj++)
+                    write_frequencies(os, _histograms_whole.at(ii, jj));
+        }
+
+        /**
+         * add frequencies written by write_frequencies(..) of an independent run with the same parameters and tracked cells
+         */
+        void merge_frequencies(std::istream &is) {
+
+            for (int pop = 0; pop < _histograms.get_dim0(); pop++)
+                for (int jj = 0; jj < _histograms.get_dim1(); jj++)
+                    for (int kk = 0; kk < _histograms.get_dim2(); kk++)
+                        merge_frequencies(is, _histograms.at(pop, jj, kk));
+
+            for (int ii = 0; ii < _histograms_whole.get_dim0(); ii++)
+                for (int jj = 0; jj < _histograms_whole.get_dim1(); jj++)
+                    merge_frequencies(is, _histograms_whole.at(ii, jj));
+        }
+
         /** 
          * get histograms for each pop, spe, and node\n
          * \n
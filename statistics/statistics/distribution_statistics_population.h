@@ -1,8 +1,11 @@
 #ifndef DISTRIBUTION_STATISTICS_POPULATION_H
 #define	DISTRIBUTION_STATISTICS_POPULATION_H
 
-#include <mutation_accumulation/probability/sample_space.h> // probability::make_uniform_sample_space
-#include <mutation_accumulation/configuration/utilities/population.h> // monte_carlo::calculate_population
+#include <limits> // std::numeric_limits
+
+#include <mutation_accumulation/array/array3D.h> // array::Array3D
+#include <mutation_accumulation/probability/sample_space.h> // probability::Make_Log_Linear_Sample_Space
+#include <mutation_accumulation/configuration/configuration/population2D.h> // monte_carlo::Population2D
 #include <mutation_accumulation/configuration/configuration/time_grid.h> // monte_carlo::Uniform_Time_Grid
 
 #include "distribution_statistics.h"
@@ -23,9 +26,23 @@ namespace monte_carlo {
 
         typedef Distribution_Statistics<Histogram_type, Configuration_type> base_type;
 
+    public:
+
+        /**
+         * populations below 2^precision_bits are resolved exactly; larger populations to within 2^-precision_bits of their size \n
+         * enum hack (Item 2)
+         */
+        enum {
+            precision_bits = 5
+        };
+
     private:
 
         Uniform_Time_Grid<time_type> _time_grid;
+        int _number_spe;
+
+        array::Array3D<double> _population_sums; // sum of populations of each tracked (pop, spe, node), for exact means
+        array::Array3D<long long int> _number_samples; // number of populations summed in each tracked (pop, spe, node)
 
     public:
 
@@ -41,7 +58,9 @@ namespace monte_carlo {
                 const Pop &pop_to_observe,
                 const Spe &spe_to_observe,
                 const Node &node_to_observe,
-                const int &observer_divisor)
+                const int &observer_divisor,
+                const std::string &file_prefix = "",
+                const Statistics_Registry &registry = Statistics_Registry())
         : base_type(
         number_pop,
         number_spe.value(),
@@ -49,16 +68,21 @@ namespace monte_carlo {
         number_spe.value(),
         time_grid_.size(),
         /* logarithmic space is necessary to plot interesting parts of histograms for each species simultaneously \n
-         * sample space that includes all integral sample values is necessary to estimate mean from discrete CDF or PMF \n
-         * "full" sample space is achieved by making suggested number of sample points larger than sample range */
-        probability::make_uniform_sample_space(1e4, population_span_histogram),
+         * log-linear space counts small populations exactly and large populations to within a relative resolution, \n
+         * so memory and work per sample grow as log(span) rather than span; \n
+         * means are summed exactly in node_crossed(..), since the CDF is coarse between large sample points */
+        probability::Make_Log_Linear_Sample_Space<population_type>::build(precision_bits, population_span_histogram),
         error_probability,
         pop_to_observe,
         spe_to_observe.value(),
         node_to_observe.value(),
         observer_divisor,
         "spe",
-        "node"), _time_grid(time_grid_) {
+        "node",
+        file_prefix,
+        registry), _time_grid(time_grid_), _number_spe(number_spe.value()),
+        _population_sums(number_pop.value(), number_spe.value(), time_grid_.size()),
+        _number_samples(number_pop.value(), number_spe.value(), time_grid_.size()) {
 
             /* sample type of Histogram_type and population type of Configuration_type should agree */
             BOOST_STATIC_ASSERT((boost::is_same<typename Histogram_type::sample_t, typename Configuration_type::population_t>::value));
@@ -66,25 +90,55 @@ namespace monte_carlo {
         }
 
         /** 
-         * dump results of a particular trial
+         * dump results of a particular trial \n
+         * populations were streamed to node_crossed(..) during the trial
          */
-        virtual void dump(const Configuration_type &configuration) {
+        virtual void dump(const Configuration_type &configuration, const Trial_Summary<Configuration_type> &summary) {
 
-            for (int pop = 0; pop < configuration.number_sub_pops(); pop++)
-                for (int spe = 0; spe < configuration.number_species(); spe++)
-                    for (int node = 0; node < configuration.number_nodes(); node++) {
-                        const population_type population = calculate_population(configuration, Pop(pop), Spe(spe), Node(node));
-                        this->update_histograms(Pop(pop), spe, node, population);
-                    }
+        }
+
+        /**
+         * statistics are attached to each trajectory
+         */
+        virtual const bool listens_to_nodes() const {
 
+            return true;
+        }
 
-            for (int spe = 0; spe < configuration.number_species(); spe++)
-                for (int node = 0; node < configuration.number_nodes(); node++) {
-                    const population_type population = calculate_population(configuration, Spe(spe), Node(node));
-                    this->update_histograms_whole(spe, node, population);
+        /**
+         * update statistics with populations at node, as the trajectory crosses it
+         */
+        virtual void node_crossed(const Node &node, const Population2D<population_type> &node_value) {
+
+            for (int pop = 0; pop < node_value.number_sub_pops(); pop++)
+                for (int spe = 0; spe < _number_spe; spe++) {
+                    if (!this->tracked(Pop(pop), spe, node.value())) continue;
+                    this->update_histograms(Pop(pop), spe, node.value(), node_value.at(pop, spe));
+                    _population_sums.at(pop, spe, node.value()) += static_cast<double> (node_value.at(pop, spe));
+                    _number_samples.at(pop, spe, node.value())++;
                 }
 
+            for (int spe = 0; spe < _number_spe; spe++) {
+                if (!this->tracked_whole(spe, node.value())) continue;
+                population_type population = static_cast<population_type> (0);
+                for (int pop = 0; pop < node_value.number_sub_pops(); pop++)
+                    population += node_value.at(pop, spe);
+                this->update_histograms_whole(spe, node.value(), population);
+            }
+
+        }
+
+        /**
+         * exact mean population of Spe-mutant in Pop sub-population at time indexed by Node \n
+         * NaN if the cell is untracked or has no samples yet \n
+         * means are not carried by write_frequencies(..)
+         */
+        const double mean(const Pop &pop, const Spe &spe, const Node &node) const {
+
+            const long long int number_samples = _number_samples.at(pop.value(), spe.value(), node.value());
+            if (number_samples == 0) return std::numeric_limits<double>::quiet_NaN();
 
+            return _population_sums.at(pop.value(), spe.value(), node.value()) / static_cast<double> (number_samples);
         }
 
         const Uniform_Time_Grid<time_type> time_grid() const {
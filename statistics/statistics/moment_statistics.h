@@ -1,7 +1,12 @@
 #ifndef MOMENT_STATS_H
 #define	MOMENT_STATS_H
 
+#include <cmath> // std::fabs
+
+#include <boost/math/distributions/normal.hpp> // boost::math::normal, boost::math::quantile
+
 #include <mutation_accumulation/parameters/parameters_fwd.h> // monte_carlo::Number_Pop
+#include <mutation_accumulation/probability/moment.h> // probability::Moment
 
 #include "statistics_gatherer.h" // monte_carlo::Statistics_Gatherer
 
@@ -11,7 +16,13 @@ namespace monte_carlo {
 
     /**
      * each sub-population is endowed with a matrix of moments\n
-     * derive from this to calculate eg MFPT
+     * derive from this to calculate eg MFPT\n
+     * \n
+     * simulation stops when the confidence interval of the observed moment is narrow relative to the moment, \n
+     * i.e. when z * standard_error <= relative_precision * |moment|, where P(|Z| > z) = error_probability, \n
+     * or when the observed moment has number_trials_max samples, or number_trials_max trials have been counted (see count_trial), \n
+     * whichever comes first \n
+     * a relative precision of zero disables the confidence-interval rule, which also never stops a simulation whose moment is still zero
      */
     template<class Moment_type, class Configuration_type>
     class Moment_Statistics : public Statistics_Gatherer<Configuration_type, typename Moment_type::Results_t> {
@@ -37,6 +48,19 @@ namespace monte_carlo {
         const int _kk_per_pop_to_observe;
 
         const long long int _number_trials_max;
+        long long int _number_trials; // trials counted by derived classes (see count_trial)
+        const double _relative_precision;
+        const double _z; // half-width of confidence interval in units of standard error
+
+    public:
+
+        /**
+         * number of samples below which the standard error is not trusted \n
+         * enum hack (Item 2)
+         */
+        enum {
+            minimum_trials = 30
+        };
 
     protected:
 
@@ -53,14 +77,19 @@ namespace monte_carlo {
                 const Pop &pop_to_observe,
                 const int &jj_per_pop_to_observe,
                 const int &kk_per_pop_to_observe,
-                const long long int &number_trials_max)
+                const long long int &number_trials_max,
+                const double &relative_precision = 0.0,
+                const double &error_probability = 0.05)
         :
         _moments(array3D_moments_type(number_pop.value(), dim1_per_pop, dim2_per_pop)),
         _moments_whole(array2D_moments_type(dim0_whole, dim1_whole)),
         _pop_to_observe(pop_to_observe),
         _jj_per_pop_to_observe(jj_per_pop_to_observe),
         _kk_per_pop_to_observe(kk_per_pop_to_observe),
-        _number_trials_max(number_trials_max) {
+        _number_trials_max(number_trials_max),
+        _number_trials(0),
+        _relative_precision(relative_precision),
+        _z(boost::math::quantile(boost::math::normal(), 1.0 - 0.5 * error_probability)) {
 
             /* check template parameter types to supplement "duck typing" */
             BOOST_STATIC_ASSERT((boost::is_base_of<probability::Moment<sample_type>, Moment_type>::value));
@@ -84,6 +113,16 @@ namespace monte_carlo {
 
         }
 
+        /**
+         * count a trial towards number_trials_max \n
+         * derived classes whose observed moment is not sampled in every trial call this once per trial
+         */
+        void count_trial() {
+
+            _number_trials++;
+
+        }
+
 
     public:
 
@@ -92,7 +131,40 @@ namespace monte_carlo {
          */
         virtual const bool converged() const {
 
-            return _moments.at(_pop_to_observe.value(), _jj_per_pop_to_observe, _kk_per_pop_to_observe).trials() >= _number_trials_max;
+            const Moment_type &observed_moment = _moments.at(_pop_to_observe.value(), _jj_per_pop_to_observe, _kk_per_pop_to_observe);
+
+            const bool cond1 = (observed_moment.trials() >= _number_trials_max) || (_number_trials >= _number_trials_max);
+
+            bool cond2 = false;
+            if ((_relative_precision > 0.0) && (observed_moment.trials() >= minimum_trials) && (observed_moment.value() != 0.0)) {
+                const double half_width = _z * observed_moment.standard_error();
+                cond2 = half_width <= _relative_precision * std::fabs(observed_moment.value());
+            }
+
+            return (cond1 || cond2);
+
+        }
+
+        /**
+         * add the moments of an independent run with the same dimensions (e.g. another thread or shard) \n
+         * requires Moment_type::merge
+         */
+        void merge(const Moment_Statistics &other) {
+
+            assert(_moments.get_dim0() == other._moments.get_dim0());
+            assert(_moments.get_dim1() == other._moments.get_dim1());
+            assert(_moments.get_dim2() == other._moments.get_dim2());
+
+            for (int pop = 0; pop < _moments.get_dim0(); pop++)
+                for (int jj = 0; jj < _moments.get_dim1(); jj++)
+                    for (int kk = 0; kk < _moments.get_dim2(); kk++)
+                        _moments.at(pop, jj, kk).merge(other._moments.at(pop, jj, kk));
+
+            _number_trials += other._number_trials;
+
+            for (int ii = 0; ii < _moments_whole.get_dim0(); ii++)
+                for (int jj = 0; jj < _moments_whole.get_dim1(); jj++)
+                    _moments_whole.at(ii, jj).merge(other._moments_whole.at(ii, jj));
 
         }
 
@@ -125,6 +197,20 @@ namespace monte_carlo {
             return array2D_results;
         }
 
+        /**
+         * get standard errors of whole-population moments
+         */
+        const array::Array2D<double> get_standard_errors_so_far_whole() const {
+
+            array::Array2D<double> array2D_errors(_moments_whole.get_dim0(), _moments_whole.get_dim1());
+
+            for (int ii = 0; ii < array2D_errors.get_dim0(); ii++)
+                for (int jj = 0; jj < array2D_errors.get_dim1(); jj++)
+                    array2D_errors.at(ii, jj) = _moments_whole.at(ii, jj).standard_error();
+
+            return array2D_errors;
+        }
+
 
     };
 
@@ -28,7 +28,9 @@ namespace monte_carlo {
                 const Number_Spe &number_spe,
                 const Pop &pop_to_observe,
                 const Spe &spe_to_observe,
-                const long long int &number_trials_max)
+                const long long int &number_trials_max,
+                const double &relative_precision = 0.0,
+                const double &error_probability = 0.05)
         : base_type(
         number_pop,
         number_spe.value(),
@@ -38,7 +40,9 @@ namespace monte_carlo {
         pop_to_observe,
         spe_to_observe.value(),
         0,
-        number_trials_max) {
+        number_trials_max,
+        relative_precision,
+        error_probability) {
 
             /* sample type of Moment_type and time type of Configuration_type should agree */
             BOOST_STATIC_ASSERT((boost::is_same<typename Moment_type::sample_t, typename Configuration_type::time_t>::value));
@@ -48,20 +52,20 @@ namespace monte_carlo {
         /** 
          * dump results of a particular trial
          */
-        virtual void dump(const Configuration_type &configuration) {
+        virtual void dump(const Configuration_type &configuration, const Trial_Summary<Configuration_type> &summary) {
 
-            for (int pop = 0; pop < configuration.number_sub_pops(); pop++)
-                for (int spe = 0; spe < configuration.number_species(); spe++) {
-                    if (fate_bool(configuration, Pop(pop), Spe(spe))) {
-                        const time_type mutation_time = configuration.mutation_times(Pop(pop), Spe(spe));
+            for (int pop = 0; pop < summary.number_sub_pops(); pop++)
+                for (int spe = 0; spe < summary.number_species(); spe++) {
+                    if (summary.fate_bool(Pop(pop), Spe(spe))) {
+                        const time_type mutation_time = summary.mutation_times(Pop(pop), Spe(spe));
                         this->update_moments(Pop(pop), spe, 0, mutation_time);
                     }
                 }
 
 
-            for (int spe = 0; spe < configuration.number_species(); spe++) {
-                if (fate_bool(configuration, Spe(spe))) {
-                    const time_type mutation_time = mutation_time_whole(configuration, Spe(spe));
+            for (int spe = 0; spe < summary.number_species(); spe++) {
+                if (summary.fate_bool(Spe(spe))) {
+                    const time_type mutation_time = summary.mutation_time_whole(Spe(spe));
                     this->update_moments_whole(spe, 0, mutation_time);
                 }
             }
@@ -1,7 +1,7 @@
 #ifndef MOMENT_STATISTICS_POPULATION_H
 #define	MOMENT_STATISTICS_POPULATION_H
 
-#include <mutation_accumulation/configuration/utilities/population.h> // monte_carlo::calculate_population
+#include <mutation_accumulation/configuration/configuration/population2D.h> // monte_carlo::Population2D
 #include <mutation_accumulation/configuration/configuration/time_grid.h> // monte_carlo::Uniform_Time_Grid
 
 #include "moment_statistics.h"
@@ -25,16 +25,24 @@ namespace monte_carlo {
     private:
 
         Uniform_Time_Grid<time_type> _time_grid;
+        int _number_spe;
 
     public:
 
         /**
          * constructor \n
+         * convergence is judged on the first species of the first sub-population at the last node, \n
+         * whose moment is not fixed by the initial condition; \n
+         * trajectories that go extinct contribute zero populations to the nodes they did not reach (see Generate_Statistics); \n
+         * number_trials_max caps the number of trials dumped
          */
         explicit Moment_Statistics_Population(
                 const Number_Pop &number_pop,
                 const Number_Spe &number_spe,
-                const Uniform_Time_Grid<time_type> &time_grid_)
+                const Uniform_Time_Grid<time_type> &time_grid_,
+                const double &relative_precision = 0.01,
+                const double &error_probability = 0.05,
+                const long long int &number_trials_max = 1000000)
         : base_type(
         number_pop,
         number_spe.value(),
@@ -43,8 +51,10 @@ namespace monte_carlo {
         time_grid_.size(),
         Pop(0),
         0,
-        0,
-        1e3), _time_grid(time_grid_) {
+        time_grid_.size() - 1,
+        number_trials_max,
+        relative_precision,
+        error_probability), _time_grid(time_grid_), _number_spe(number_spe.value()) {
 
             /* sample type of Moment_type and population type of Configuration_type should agree */
             BOOST_STATIC_ASSERT((boost::is_same<typename Moment_type::sample_t, typename Configuration_type::population_t>::value));
@@ -52,24 +62,38 @@ namespace monte_carlo {
         }
 
         /** 
-         * dump results of a particular trial
+         * dump results of a particular trial \n
+         * populations were streamed to node_crossed(..) during the trial
          */
-        virtual void dump(const Configuration_type &configuration) {
+        virtual void dump(const Configuration_type &, const Trial_Summary<Configuration_type> &) {
+
+            this->count_trial();
+        }
 
-            for (int pop = 0; pop < configuration.number_sub_pops(); pop++)
-                for (int spe = 0; spe < configuration.number_species(); spe++)
-                    for (int node = 0; node < configuration.number_nodes(); node++) {
-                        const population_type population = calculate_population(configuration, Pop(pop), Spe(spe), Node(node));
-                        this->update_moments(Pop(pop), spe, node, population);
-                    }
+        /**
+         * statistics are attached to each trajectory
+         */
+        virtual const bool listens_to_nodes() const {
 
+            return true;
+        }
+
+        /**
+         * update statistics with populations at node, as the trajectory crosses it
+         */
+        virtual void node_crossed(const Node &node, const Population2D<population_type> &node_value) {
 
-            for (int spe = 0; spe < configuration.number_species(); spe++)
-                for (int node = 0; node < configuration.number_nodes(); node++) {
-                    const population_type population = calculate_population(configuration, Spe(spe), Node(node));
-                    this->update_moments_whole(spe, node, population);
+            for (int pop = 0; pop < node_value.number_sub_pops(); pop++)
+                for (int spe = 0; spe < _number_spe; spe++) {
+                    this->update_moments(Pop(pop), spe, node.value(), node_value.at(pop, spe));
                 }
 
+            for (int spe = 0; spe < _number_spe; spe++) {
+                population_type population = static_cast<population_type> (0);
+                for (int pop = 0; pop < node_value.number_sub_pops(); pop++)
+                    population += node_value.at(pop, spe);
+                this->update_moments_whole(spe, node.value(), population);
+            }
 
         }
 
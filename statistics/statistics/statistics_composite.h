@@ -0,0 +1,172 @@
+#ifndef STATISTICS_COMPOSITE_H
+#define	STATISTICS_COMPOSITE_H
+
+#include <boost/static_assert.hpp> // BOOST_STATIC_ASSERT
+#include <boost/type_traits/is_same.hpp> // boost::is_same
+#include <boost/type_traits/is_base_of.hpp> // boost::is_base_of
+
+#include "statistics_gatherer.h" // monte_carlo::Statistics_Gatherer
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * composite has converged when all of its children have converged
+     */
+    struct Converge_All {
+
+        static const bool converged(const bool &first_converged, const bool &second_converged) {
+
+            return (first_converged && second_converged);
+        }
+    };
+
+    /**
+     * composite has converged when any of its children has converged \n
+     * (e.g. stop once the statistic with the tightest error target has converged)
+     */
+    struct Converge_Any {
+
+        static const bool converged(const bool &first_converged, const bool &second_converged) {
+
+            return (first_converged || second_converged);
+        }
+    };
+
+    /**
+     * composite has converged when its primary (first) child has converged \n
+     * the second child is a passenger that is updated with the same trajectories
+     */
+    struct Converge_First {
+
+        static const bool converged(const bool &first_converged, const bool &) {
+
+            return first_converged;
+        }
+    };
+
+    /**
+     * fans the trajectories of a single Monte Carlo run out to two statistics gatherers\n
+     * gatherers are nested to observe more than two quantities, \n
+     * e.g. Statistics_Composite<S1, Statistics_Composite<S2, S3> > \n
+     * \n
+     * Composite Pattern: the composite is itself a Statistics_Gatherer, so it can be passed to Generate_Statistics\n
+     * results are those of the first (primary) gatherer; other results are read from the children directly\n
+     * \n
+     * the composite holds references to its children, which must outlive it \n
+     * (children are not copied, since each child owns histograms that write to disk on destruction)
+     */
+    template <class First_Statistics, class Second_Statistics, class Convergence_Policy = Converge_All>
+    class Statistics_Composite : public Statistics_Gatherer<typename First_Statistics::Configuration_t, typename First_Statistics::Results_t> {
+    private:
+
+        typedef typename First_Statistics::Configuration_t Configuration_type; // Item 42
+        typedef typename First_Statistics::Results_t Results_type;
+
+        typedef Statistics_Gatherer<Configuration_type, Results_type> base_type;
+
+    public:
+
+        typedef typename base_type::Summary_t Summary_t;
+
+    private:
+
+        First_Statistics &_first;
+        Second_Statistics &_second;
+
+    public:
+
+        /**
+         * constructor \n
+         */
+        explicit Statistics_Composite(First_Statistics &first_, Second_Statistics &second_)
+        : _first(first_), _second(second_) {
+
+            /* children should observe the same stochastic process */
+            BOOST_STATIC_ASSERT((boost::is_same<Configuration_type, typename Second_Statistics::Configuration_t>::value));
+            BOOST_STATIC_ASSERT((boost::is_base_of<Statistics_Gatherer<Configuration_type, typename Second_Statistics::Results_t>, Second_Statistics>::value));
+
+        }
+
+        /**
+         * dump results of a particular trial into each child
+         */
+        virtual void dump(const Configuration_type &configuration, const Summary_t &summary) {
+
+            _first.dump(configuration, summary);
+            _second.dump(configuration, summary);
+
+        }
+
+        /**
+         * composite listens to nodes if any child does
+         */
+        virtual const bool listens_to_nodes() const {
+
+            return (_first.listens_to_nodes() || _second.listens_to_nodes());
+        }
+
+        /**
+         * composite needs decided sub-populations if any child does
+         */
+        virtual const bool needs_decided_sub_pops() const {
+
+            return (_first.needs_decided_sub_pops() || _second.needs_decided_sub_pops());
+        }
+
+        /**
+         * pass node values to each child that listens to nodes
+         */
+        virtual void node_crossed(const Node &node, const Population2D<typename Configuration_type::population_t> &node_value) {
+
+            if (_first.listens_to_nodes()) _first.node_crossed(node, node_value);
+            if (_second.listens_to_nodes()) _second.node_crossed(node, node_value);
+
+        }
+
+        /**
+         * combine convergence of children according to Convergence_Policy
+         */
+        virtual const bool converged() const {
+
+            return Convergence_Policy::converged(_first.converged(), _second.converged());
+        }
+
+        /**
+         * results of primary gatherer
+         */
+        virtual const array::Array3D<Results_type> get_results_so_far() const {
+
+            return _first.get_results_so_far();
+        }
+
+        /**
+         * whole-population results of primary gatherer
+         */
+        virtual const array::Array2D<Results_type> get_results_so_far_whole() const {
+
+            return _first.get_results_so_far_whole();
+        }
+
+        /**
+         * primary gatherer
+         */
+        const First_Statistics &first() const {
+
+            return _first;
+        }
+
+        /**
+         * secondary gatherer
+         */
+        const Second_Statistics &second() const {
+
+            return _second;
+        }
+
+    };
+
+}
+
+#endif	/* STATISTICS_COMPOSITE_H */
@@ -2,7 +2,7 @@
 #define	STATISTICS_EXTINCTION_H
 
 #include <mutation_accumulation/probability/sample_space.h> // probability::make_uniform_sample_space
-#include <mutation_accumulation/configuration/utilities/fpt_extinction.h>  // monte_carlo::extinction_time_whole
+#include <mutation_accumulation/utility/configuration_traits.h> // configuration_categories::branching_category
 
 #include "distribution_statistics.h"
 
@@ -10,6 +10,29 @@
 
 namespace monte_carlo {
 
+    namespace statistics_extinction_detail {
+
+        /**
+         * cells of the last species of a branching configuration never die, \n
+         * so a sub-population in which every species has arisen never extinguishes, \n
+         * and extinction times are unaffected by freezing decided sub-populations
+         */
+        inline const bool needs_decided_sub_pops(const configuration_categories::branching_category &) {
+
+            return false;
+        }
+
+        /**
+         * conservative for other configurations, in which decided sub-populations may still extinguish
+         */
+        template <class Category>
+        const bool needs_decided_sub_pops(const Category &) {
+
+            return true;
+        }
+
+    }
+
     /** 
      * calculate distribution of time at which pop sub-population goes extinct
      */
@@ -30,7 +53,9 @@ namespace monte_carlo {
                 const time_type &time_span,
                 const double &error_probability,
                 const Pop &pop_to_observe,
-                const int &observer_divisor)
+                const int &observer_divisor,
+                const std::string &file_prefix = "",
+                const Statistics_Registry &registry = Statistics_Registry())
         : base_type(
         number_pop,
         1,
@@ -44,7 +69,9 @@ namespace monte_carlo {
         0,
         observer_divisor,
         "xxx",
-        "xxx") {
+        "xxx",
+        file_prefix,
+        registry) {
 
             /* sample type of Histogram_type and time type of Configuration_type should agree */
             BOOST_STATIC_ASSERT((boost::is_same<typename Histogram_type::sample_t, typename Configuration_type::time_t>::value));
@@ -54,20 +81,28 @@ namespace monte_carlo {
         /** 
          * dump results of a particular trial
          */
-        virtual void dump(const Configuration_type &configuration) {
+        virtual void dump(const Configuration_type &, const Trial_Summary<Configuration_type> &summary) {
 
-            for (int pop = 0; pop < configuration.number_sub_pops(); pop++) {
-                const time_type extinction_time = configuration.extinction_times(Pop(pop));
+            for (int pop = 0; pop < summary.number_sub_pops(); pop++) {
+                const time_type extinction_time = summary.extinction_times(Pop(pop));
                 this->update_histograms(Pop(pop), 0, 0, extinction_time);
             }
 
             {
-                const time_type extinction_time = monte_carlo::extinction_time_whole(configuration);
+                const time_type extinction_time = summary.extinction_time_whole();
                 this->update_histograms_whole(0, 0, extinction_time);
             }
 
         }
 
+        /**
+         * decided per configuration category (tag dispatch)
+         */
+        virtual const bool needs_decided_sub_pops() const {
+
+            return statistics_extinction_detail::needs_decided_sub_pops(typename Configuration_type::category());
+        }
+
 
     };
 
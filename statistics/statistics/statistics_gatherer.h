@@ -4,6 +4,8 @@
 #include <boost/type_traits.hpp> // boost::is_base_of
 
 #include <mutation_accumulation/configuration/configuration/configuration_interface.h> // monte_carlo::Configuration_Interface 
+#include <mutation_accumulation/configuration/configuration/node_listener.h> // monte_carlo::Node_Listener 
+#include <mutation_accumulation/configuration/utilities/trial_summary.h> // monte_carlo::Trial_Summary 
 #include <mutation_accumulation/array/array3D.h> // array::Array3D 
 #include <mutation_accumulation/array/array2D.h> // array::Array2D 
 
@@ -14,15 +16,18 @@ namespace monte_carlo {
     /**
      * abstract base class that stores statistics generated by Configuration class\n
      * defines the interface used by generate_statistics(..) \n
+     * statistics of path populations are streamed: gatherers that return true from listens_to_nodes() \n
+     * are attached to each trajectory and update themselves in node_crossed(..) as nodes are crossed \n
      * may use this class polymorphically (virtual destructor) \n
      * may not instantiate (ctor is protected)\n
      */
     template <class Configuration_type, class Results_type>
-    class Statistics_Gatherer {
+    class Statistics_Gatherer : public Node_Listener<typename Configuration_type::population_t> {
     public:
 
         typedef Configuration_type Configuration_t;
         typedef Results_type Results_t;
+        typedef Trial_Summary<Configuration_type> Summary_t;
         
     protected:
 
@@ -49,9 +54,38 @@ namespace monte_carlo {
         /** 
          * dump results of a particular trial\n
          * cannot pull the loop over pop, spe, node up to this level without also pulling up the size of the 3D array\n
-         * (statistics for extinction times makes the problem concrete)
+         * (statistics for extinction times makes the problem concrete)\n
+         * first-passage data should be read from the summary, which was built once for this trial; \n
+         * the configuration is passed for statistics that need its path
          */
-        virtual void dump(const Configuration_type &configuration) = 0;
+        virtual void dump(const Configuration_type &configuration, const Summary_t &summary) = 0;
+
+        /**
+         * returns true if statistics should be attached to each trajectory to receive node values as they are crossed\n
+         * gatherers of first-passage data need not override this
+         */
+        virtual const bool listens_to_nodes() const {
+
+            return false;
+        }
+
+        /**
+         * returns true if statistics need sub-populations to be updated after their fate has been decided \n
+         * (see Path_Policy_Base::freeze_decided); statistics of path populations do, \n
+         * gatherers of mutation times and fates need not override this
+         */
+        virtual const bool needs_decided_sub_pops() const {
+
+            return listens_to_nodes();
+        }
+
+        /**
+         * update statistics with populations at a node of the current trajectory \n
+         * gatherers that listen to nodes override this
+         */
+        virtual void node_crossed(const Node &, const Population2D<typename Configuration_type::population_t> &) {
+
+        }
 
         /**
          * returns true if statistics of observed population have converged
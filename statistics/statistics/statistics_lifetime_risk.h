@@ -2,7 +2,6 @@
 #define	STATISTICS_LIFETIME_RISK_H
 
 #include <mutation_accumulation/probability/sample_space.h> // probability::make_bernoulli_sample_space
-#include <mutation_accumulation/configuration/utilities/lifetime_risk.h> // monte_carlo::mutation_occurred_within_timeSpan 
 #include <mutation_accumulation/probability/pmf.h> 
 
 #include "distribution_statistics.h" 
@@ -38,7 +37,9 @@ namespace monte_carlo {
                     const double &error_probability,
                     const Pop &pop_to_observe,
                     const Spe &spe_to_observe,
-                    const int &observer_divisor)
+                    const int &observer_divisor,
+                    const std::string &file_prefix = "",
+                    const Statistics_Registry &registry = Statistics_Registry())
             : base_type(
             number_pop,
             number_spe.value(),
@@ -52,7 +53,9 @@ namespace monte_carlo {
             0,
             observer_divisor,
             "spe",
-            "xxx") {
+            "xxx",
+            file_prefix,
+            registry) {
 
                 /* sample type of Histogram_type should be bool */
                 BOOST_STATIC_ASSERT((boost::is_same<typename Histogram_type::sample_t, bool>::value));
@@ -62,16 +65,16 @@ namespace monte_carlo {
             /** 
              * dump results of a particular trial
              */
-            virtual void dump(const Configuration_type &configuration) {
+            virtual void dump(const Configuration_type &, const Trial_Summary<Configuration_type> &summary) {
 
-                for (int pop = 0; pop < configuration.number_sub_pops(); pop++)
-                    for (int spe = 0; spe < configuration.number_species(); spe++) {
-                        const bool fate = monte_carlo::mutation_occurred_within_timeSpan(configuration, Pop(pop), Spe(spe));
+                for (int pop = 0; pop < summary.number_sub_pops(); pop++)
+                    for (int spe = 0; spe < summary.number_species(); spe++) {
+                        const bool fate = summary.mutation_occurred_within_timeSpan(Pop(pop), Spe(spe));
                         this->update_histograms(Pop(pop), spe, 0, fate);
                     }
 
-                for (int spe = 0; spe < configuration.number_species(); spe++) {
-                    const bool fate = monte_carlo::mutation_occurred_within_timeSpan(configuration, Spe(spe));
+                for (int spe = 0; spe < summary.number_species(); spe++) {
+                    const bool fate = summary.mutation_occurred_within_timeSpan(Spe(spe));
                     this->update_histograms_whole(spe, 0, fate);
                 }
 
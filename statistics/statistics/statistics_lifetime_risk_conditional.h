@@ -0,0 +1,164 @@
+#ifndef STATISTICS_LIFETIME_RISK_CONDITIONAL_H
+#define	STATISTICS_LIFETIME_RISK_CONDITIONAL_H
+
+#include <cmath> // std::exp, std::expm1
+
+#include <boost/math/distributions/normal.hpp> // boost::math::normal, boost::math::cdf
+#include <boost/static_assert.hpp> // BOOST_STATIC_ASSERT
+#include <boost/type_traits/integral_constant.hpp> // boost::true_type, boost::false_type
+
+#include <mutation_accumulation/probability/mean.h> // probability::Mean
+#include <mutation_accumulation/configuration/configuration/branching_discrete.h> // monte_carlo::Branching_Discrete
+
+#include "moment_statistics.h"
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace Statistics_Lifetime_Risk_Conditional_namespace {
+
+        typedef probability::Mean<double> Moment_type;
+
+        /**
+         * true if configurations of type configuration_type can calculate the probability that a mutation arises \n
+         * in the rest of a trajectory, so that the last mutation step can be integrated out; false by default
+         */
+        template <class configuration_type>
+        struct integrates_last_mutation : public boost::false_type {
+        };
+
+        template <class population_type>
+        struct integrates_last_mutation<Branching_Discrete<population_type> > : public boost::true_type {
+        };
+
+        /**
+         * branching configurations calculate it from the current populations (see Branching_Discrete::log_probability_no_mutation)
+         */
+        template <class population_type>
+        const double log_probability_no_mutation(
+        const Branching_Discrete<population_type> &configuration,
+        const Pop &pop,
+        const Spe &spe,
+        const typename Branching_Discrete<population_type>::time_t &remaining_time) {
+
+            return configuration.log_probability_no_mutation(pop, spe, remaining_time);
+        }
+
+        /**
+         * calculate the probability that sub-population pop accumulates the last species within time span \n
+         * by conditional Monte Carlo: trajectories stop once the penultimate species has arisen in every sub-population \n
+         * (see Wait_For_Penultimate_Species_In_All_SubPops), and each trial contributes the probability, \n
+         * given the populations at that time, that the last species arises in the rest of the time span, \n
+         * rather than a 0/1 outcome; the mean contribution is an unbiased estimate of the lifetime risk, \n
+         * with lower variance, from shorter trajectories \n
+         * \n
+         * results have one entry per sub-population (and one for the whole population) \n
+         * simulation stops when the standard error of the observed probability is error_probability times the probability \n
+         * (see Statistics_Lifetime_Risk_Weighted)
+         */
+        template<class Configuration_type>
+        class Statistics_Lifetime_Risk_Conditional : public Moment_Statistics<Moment_type, Configuration_type> {
+        private:
+
+            typedef Moment_Statistics<Moment_type, Configuration_type> base_type;
+            typedef typename Configuration_type::time_t time_type; // Item 42
+
+        private:
+
+            /**
+             * error probability whose confidence interval is one standard error wide on each side
+             */
+            static const double one_standard_error() {
+
+                return 2.0 * boost::math::cdf(boost::math::complement(boost::math::normal(), 1.0));
+            }
+
+        public:
+
+            /**
+             * constructor \n
+             * rejects, at compile time, configurations that cannot integrate out the last mutation step
+             */
+            explicit Statistics_Lifetime_Risk_Conditional(
+                    const Number_Pop &number_pop,
+                    const double &error_probability,
+                    const Pop &pop_to_observe)
+            : base_type(
+            number_pop,
+            1,
+            1,
+            1,
+            1,
+            pop_to_observe,
+            0,
+            0,
+            static_cast<long long int> (1000000000000), // 1e12LL, as in Distribution_Statistics
+            error_probability,
+            one_standard_error()) {
+
+                BOOST_STATIC_ASSERT((integrates_last_mutation<Configuration_type>::value));
+            }
+
+            /**
+             * dump results of a particular trial
+             */
+            virtual void dump(const Configuration_type &configuration, const Trial_Summary<Configuration_type> &summary) {
+
+                const Spe last_species(summary.number_species() - 1);
+                const time_type remaining_time = configuration.get_last_node_time() - configuration.get_time();
+
+                double log_probability_no_mutation_whole = 0.0;
+
+                for (int pop = 0; pop < summary.number_sub_pops(); pop++) {
+
+                    if (summary.mutation_occurred(Pop(pop), last_species)) {
+                        this->update_moments(Pop(pop), 0, 0, summary.mutation_occurred_within_timeSpan(Pop(pop), last_species) ? 1.0 : 0.0);
+                        continue;
+                    }
+
+                    const double log_probability = log_probability_no_mutation(configuration, Pop(pop), last_species, remaining_time);
+                    this->update_moments(Pop(pop), 0, 0, 0.0 - std::expm1(log_probability)); // not -expm1(..), which gives -0
+                    log_probability_no_mutation_whole += log_probability;
+                }
+
+                if (summary.mutation_occurred(last_species))
+                    this->update_moments_whole(0, 0, summary.mutation_occurred_within_timeSpan(last_species) ? 1.0 : 0.0);
+                else
+                    this->update_moments_whole(0, 0, 0.0 - std::expm1(log_probability_no_mutation_whole));
+
+            }
+
+        };
+
+    }
+
+    using Statistics_Lifetime_Risk_Conditional_namespace::Statistics_Lifetime_Risk_Conditional;
+    using Statistics_Lifetime_Risk_Conditional_namespace::integrates_last_mutation;
+
+    /**
+     * probability that sub-population pop accumulates the last species within time span
+     */
+    template<class Configuration_type>
+    const double probability_mutation_fate(
+    const Statistics_Lifetime_Risk_Conditional<Configuration_type> &statistics,
+    const Pop &pop) {
+
+        return statistics.get_results_so_far().at(pop.value(), 0, 0);
+
+    }
+
+    /**
+     * probability that whole population accumulates full complement of mutations within time span
+     */
+    template<class Configuration_type>
+    const double probability_mutation_fate(
+    const Statistics_Lifetime_Risk_Conditional<Configuration_type> &statistics) {
+
+        return statistics.get_results_so_far_whole().at(0, 0);
+
+    }
+
+}
+
+#endif	/* STATISTICS_LIFETIME_RISK_CONDITIONAL_H */
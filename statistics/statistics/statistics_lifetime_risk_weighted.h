@@ -0,0 +1,135 @@
+#ifndef STATISTICS_LIFETIME_RISK_WEIGHTED_H
+#define	STATISTICS_LIFETIME_RISK_WEIGHTED_H
+
+#include <boost/math/distributions/normal.hpp> // boost::math::normal, boost::math::cdf
+
+#include <mutation_accumulation/probability/mean.h> // probability::Mean
+
+#include "moment_statistics.h"
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace Statistics_Lifetime_Risk_Weighted_namespace {
+
+        typedef probability::Mean<double> Moment_type;
+
+        /**
+         * calculate the probability that sub-population pop accumulates spe mutations within time span \n
+         * from paths simulated with tilted parameters (importance sampling): \n
+         * each trial contributes its likelihood ratio if the mutations accumulated, and zero otherwise, \n
+         * so the mean contribution is an unbiased estimate of the nominal probability \n
+         * \n
+         * simulation stops when the standard error of the observed probability is error_probability times the probability, \n
+         * which is the precision at which Statistics_Lifetime_Risk stops (1/error_probability^2 successes)
+         */
+        template<class Configuration_type>
+        class Statistics_Lifetime_Risk_Weighted : public Moment_Statistics<Moment_type, Configuration_type> {
+        private:
+
+            typedef Moment_Statistics<Moment_type, Configuration_type> base_type;
+
+        private:
+
+            /**
+             * error probability whose confidence interval is one standard error wide on each side
+             */
+            static const double one_standard_error() {
+
+                return 2.0 * boost::math::cdf(boost::math::complement(boost::math::normal(), 1.0));
+            }
+
+        public:
+
+            /**
+             * constructor \n
+             */
+            explicit Statistics_Lifetime_Risk_Weighted(
+                    const Number_Pop &number_pop,
+                    const Number_Spe &number_spe,
+                    const double &error_probability,
+                    const Pop &pop_to_observe,
+                    const Spe &spe_to_observe)
+            : base_type(
+            number_pop,
+            number_spe.value(),
+            1,
+            number_spe.value(),
+            1,
+            pop_to_observe,
+            spe_to_observe.value(),
+            0,
+            static_cast<long long int> (1000000000000), // 1e12LL, as in Distribution_Statistics
+            error_probability,
+            one_standard_error()) {
+
+            }
+
+            /**
+             * dump results of a particular trial
+             */
+            virtual void dump(const Configuration_type &configuration, const Trial_Summary<Configuration_type> &summary) {
+
+                const double weight = configuration.likelihood_ratio();
+
+                for (int pop = 0; pop < summary.number_sub_pops(); pop++)
+                    for (int spe = 0; spe < summary.number_species(); spe++) {
+                        const bool fate = summary.mutation_occurred_within_timeSpan(Pop(pop), Spe(spe));
+                        this->update_moments(Pop(pop), spe, 0, fate ? weight : 0.0);
+                    }
+
+                for (int spe = 0; spe < summary.number_species(); spe++) {
+                    const bool fate = summary.mutation_occurred_within_timeSpan(Spe(spe));
+                    this->update_moments_whole(spe, 0, fate ? weight : 0.0);
+                }
+
+            }
+
+        };
+
+    }
+
+    using Statistics_Lifetime_Risk_Weighted_namespace::Statistics_Lifetime_Risk_Weighted;
+
+    /**
+     * probability that sub-population pop accumulates spe mutations within time span
+     */
+    template<class Configuration_type>
+    const double probability_mutation_fate(
+    const Statistics_Lifetime_Risk_Weighted<Configuration_type> &statistics,
+    const Pop &pop,
+    const Spe &spe) {
+
+        return statistics.get_results_so_far().at(pop.value(), spe.value(), 0);
+
+    }
+
+    /**
+     * probability that whole population accumulates spe mutations within time span
+     */
+    template<class Configuration_type>
+    const double probability_mutation_fate(
+    const Statistics_Lifetime_Risk_Weighted<Configuration_type> &statistics,
+    const Spe &spe) {
+
+        return statistics.get_results_so_far_whole().at(spe.value(), 0);
+
+    }
+
+    /**
+     * probability that whole population accumulates full complement of mutations within time span
+     */
+    template<class Configuration_type>
+    const double probability_mutation_fate(
+    const Statistics_Lifetime_Risk_Weighted<Configuration_type> &statistics) {
+
+        const Spe last_species(statistics.get_results_so_far_whole().get_dim0() - 1);
+
+        return probability_mutation_fate(statistics, last_species);
+
+    }
+
+}
+
+#endif	/* STATISTICS_LIFETIME_RISK_WEIGHTED_H */
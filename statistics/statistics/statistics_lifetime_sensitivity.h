@@ -0,0 +1,91 @@
+#ifndef STATISTICS_LIFETIME_SENSITIVITY_H
+#define	STATISTICS_LIFETIME_SENSITIVITY_H
+
+#include <vector> // std::vector
+
+#include <mutation_accumulation/probability/mean.h> // probability::Mean
+
+#include "moment_statistics.h"
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    namespace Statistics_Lifetime_Sensitivity_namespace {
+
+        typedef probability::Mean<double> Moment_type;
+
+        /**
+         * calculate the derivatives of the probability that the last species arises within time span \n
+         * with respect to each mutation rate and to symmetry, by the likelihood-ratio (score-function) method: \n
+         * each trial contributes likelihood_ratio * fate * score, where score is accumulated by the configuration (see track_score()) \n
+         * \n
+         * results are indexed by (pop, parameter, 0) and, for the whole population, by (parameter, 0); \n
+         * parameters are the mutation rates, in order, followed by symmetry \n
+         * \n
+         * never converges on its own: combine with a lifetime-risk gatherer that decides when to stop, \n
+         * e.g. Statistics_Composite<Statistics_Lifetime_Risk<C>, Statistics_Lifetime_Sensitivity<C>, Converge_First>
+         */
+        template<class Configuration_type>
+        class Statistics_Lifetime_Sensitivity : public Moment_Statistics<Moment_type, Configuration_type> {
+        private:
+
+            typedef Moment_Statistics<Moment_type, Configuration_type> base_type;
+
+        public:
+
+            /**
+             * constructor \n
+             * number of parameters is number of mutation rates plus one (symmetry), i.e. number of species
+             */
+            explicit Statistics_Lifetime_Sensitivity(
+                    const Number_Pop &number_pop,
+                    const Number_Spe &number_spe)
+            : base_type(
+            number_pop,
+            number_spe.value(),
+            1,
+            number_spe.value(),
+            1,
+            Pop(0),
+            0,
+            0,
+            static_cast<long long int> (1000000000000)) { // 1e12LL, as in Distribution_Statistics
+
+            }
+
+            /**
+             * dump results of a particular trial
+             */
+            virtual void dump(const Configuration_type &configuration, const Trial_Summary<Configuration_type> &summary) {
+
+                const std::vector<double> score = configuration.score();
+                if (score.size() != static_cast<std::vector<double>::size_type> (summary.number_species())) {
+                    std::cerr << "configuration has not accumulated a score of " << summary.number_species() << " derivatives (see track_score)" << std::endl;
+                    assert(false);
+                }
+
+                const double weight = configuration.likelihood_ratio();
+                const Spe last_species(summary.number_species() - 1);
+
+                for (int pop = 0; pop < summary.number_sub_pops(); pop++) {
+                    const bool fate = summary.mutation_occurred_within_timeSpan(Pop(pop), last_species);
+                    for (std::vector<double>::size_type parameter = 0; parameter < score.size(); parameter++)
+                        this->update_moments(Pop(pop), parameter, 0, fate ? weight * score.at(parameter) : 0.0);
+                }
+
+                const bool fate = summary.mutation_occurred_within_timeSpan(last_species);
+                for (std::vector<double>::size_type parameter = 0; parameter < score.size(); parameter++)
+                    this->update_moments_whole(parameter, 0, fate ? weight * score.at(parameter) : 0.0);
+
+            }
+
+        };
+
+    }
+
+    using Statistics_Lifetime_Sensitivity_namespace::Statistics_Lifetime_Sensitivity;
+
+}
+
+#endif	/* STATISTICS_LIFETIME_SENSITIVITY_H */
@@ -2,7 +2,6 @@
 #define	STATISTICS_MUTATION_H
 
 #include <mutation_accumulation/probability/sample_space.h> // probability::make_uniform_sample_space
-#include <mutation_accumulation/configuration/utilities/fpt_mutation.h>  // monte_carlo::mutation_time_whole
 
 #include "distribution_statistics.h" 
 
@@ -41,7 +40,9 @@ namespace monte_carlo {
                 const double &error_probability,
                 const Pop &pop_to_observe,
                 const Spe &spe_to_observe,
-                const int &observer_divisor)
+                const int &observer_divisor,
+                const std::string &file_prefix = "",
+                const Statistics_Registry &registry = Statistics_Registry())
         : base_type(
         number_pop,
         number_spe.value(),
@@ -55,7 +56,9 @@ namespace monte_carlo {
         0,
         observer_divisor,
         "spe",
-        "xxx") {
+        "xxx",
+        file_prefix,
+        registry) {
 
             error_checking();
 
@@ -72,7 +75,9 @@ namespace monte_carlo {
                 const double &error_probability,
                 const Pop &pop_to_observe,
                 const Spe &spe_to_observe,
-                const int &observer_divisor)
+                const int &observer_divisor,
+                const std::string &file_prefix = "",
+                const Statistics_Registry &registry = Statistics_Registry())
         : base_type(
         number_pop,
         number_spe.value(),
@@ -86,7 +91,9 @@ namespace monte_carlo {
         0,
         observer_divisor,
         "spe",
-        "xxx") {
+        "xxx",
+        file_prefix,
+        registry) {
 
             error_checking();
 
@@ -95,16 +102,16 @@ namespace monte_carlo {
         /** 
          * dump results of a particular trial
          */
-        virtual void dump(const Configuration_type &configuration) {
+        virtual void dump(const Configuration_type &, const Trial_Summary<Configuration_type> &summary) {
 
-            for (int pop = 0; pop < configuration.number_sub_pops(); pop++)
-                for (int spe = 0; spe < configuration.number_species(); spe++) {
-                    const time_type mutation_time = configuration.mutation_times(Pop(pop), Spe(spe));                    
+            for (int pop = 0; pop < summary.number_sub_pops(); pop++)
+                for (int spe = 0; spe < summary.number_species(); spe++) {
+                    const time_type mutation_time = summary.mutation_times(Pop(pop), Spe(spe));                    
                     this->update_histograms(Pop(pop), spe, 0, mutation_time);
                 }
 
-            for (int spe = 0; spe < configuration.number_species(); spe++) {
-                const time_type mutation_time = monte_carlo::mutation_time_whole(configuration, Spe(spe));
+            for (int spe = 0; spe < summary.number_species(); spe++) {
+                const time_type mutation_time = summary.mutation_time_whole(Spe(spe));
                 this->update_histograms_whole(spe, 0, mutation_time);
             }
 
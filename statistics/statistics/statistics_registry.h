@@ -0,0 +1,196 @@
+#ifndef STATISTICS_REGISTRY_H
+#define	STATISTICS_REGISTRY_H
+
+#include <vector> // std::vector
+#include <string> // std::string
+#include <fstream> // std::ifstream
+#include <iostream> // std::cerr
+#include <algorithm> // std::find
+#include <cassert> // assert
+
+#include <boost/algorithm/string.hpp> // boost::split, boost::trim
+#include <boost/lexical_cast.hpp> // boost::lexical_cast
+
+/*************************************************************************/
+
+namespace monte_carlo {
+
+    /**
+     * set of indices along one dimension of a histogram matrix: either all indices or an explicit list \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    class Index_Selection {
+    private:
+
+        bool _all;
+        std::vector<int> _indices;
+
+    public:
+
+        /**
+         * select all indices
+         */
+        explicit Index_Selection() : _all(true) {
+
+        }
+
+        /**
+         * select listed indices only (an empty list selects none)
+         */
+        explicit Index_Selection(const std::vector<int> &indices_) : _all(false), _indices(indices_) {
+
+        }
+
+        const bool contains(const int &index) const {
+
+            return _all || (std::find(_indices.begin(), _indices.end(), index) != _indices.end());
+        }
+
+    };
+
+    /**
+     * declares which cells of the histogram matrices held by Distribution_Statistics are tracked\n
+     * per-sub-population cells are indexed by (pop, jj, kk), whole-population cells by (ii, jj), where \n
+     * jj (per-pop) and ii (whole) usually label species, and kk (per-pop) and jj (whole) usually label nodes \n
+     * \n
+     * untracked cells are neither allocated, updated, nor written to disk \n
+     * the default registry tracks every cell \n
+     * compiler-generated copy constructor and assignment operator are fine
+     */
+    class Statistics_Registry {
+    private:
+
+        Index_Selection _pops;
+        Index_Selection _species;
+        Index_Selection _nodes;
+        bool _whole;
+
+    public:
+
+        /**
+         * track every cell
+         */
+        explicit Statistics_Registry() : _whole(true) {
+
+        }
+
+        void select_pops(const Index_Selection &pops_) {
+
+            _pops = pops_;
+        }
+
+        void select_species(const Index_Selection &species_) {
+
+            _species = species_;
+        }
+
+        void select_nodes(const Index_Selection &nodes_) {
+
+            _nodes = nodes_;
+        }
+
+        void select_whole(const bool &whole_) {
+
+            _whole = whole_;
+        }
+
+        /**
+         * true if sub-population cell is tracked
+         */
+        const bool tracked(const int &pop, const int &jj, const int &kk) const {
+
+            return _pops.contains(pop) && _species.contains(jj) && _nodes.contains(kk);
+        }
+
+        /**
+         * true if whole-population cell is tracked
+         */
+        const bool tracked_whole(const int &ii, const int &jj) const {
+
+            return _whole && _species.contains(ii) && _nodes.contains(jj);
+        }
+
+    };
+
+    namespace statistics_registry_detail {
+
+        /**
+         * parse "all", "none", or a comma-separated list of indices
+         */
+        inline const Index_Selection parse_index_selection(const std::string &values) {
+
+            if (values == "all") return Index_Selection();
+            if (values == "none") return Index_Selection(std::vector<int>());
+
+            std::vector<std::string> tokens;
+            boost::split(tokens, values, boost::is_any_of(","));
+
+            std::vector<int> indices;
+            for (std::vector<std::string>::size_type ii = 0; ii < tokens.size(); ii++)
+                indices.push_back(boost::lexical_cast<int> (boost::trim_copy(tokens.at(ii))));
+
+            return Index_Selection(indices);
+        }
+
+    }
+
+    /**
+     * apply a single option that selects tracked cells (see read_statistics_registry) \n
+     * return false if key is not such an option
+     */
+    inline const bool read_statistics_registry_option(Statistics_Registry &registry, const std::string &key, const std::string &values) {
+
+        if (key == "track_pops") {
+            registry.select_pops(statistics_registry_detail::parse_index_selection(values));
+        } else if (key == "track_spe") {
+            registry.select_species(statistics_registry_detail::parse_index_selection(values));
+        } else if (key == "track_nodes") {
+            registry.select_nodes(statistics_registry_detail::parse_index_selection(values));
+        } else if (key == "track_whole") {
+            registry.select_whole(boost::lexical_cast<int> (values) != 0);
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * read optional trailing lines of an input file that select the tracked cells, e.g.\n
+     * track_pops = none \n
+     * track_spe = 3 \n
+     * track_nodes = all \n
+     * track_whole = 1 \n
+     * any line may be omitted; if none is present every cell is tracked
+     */
+    inline const Statistics_Registry read_statistics_registry(std::ifstream &ifs) {
+
+        Statistics_Registry registry;
+
+        std::string text_line;
+        while (std::getline(ifs, text_line)) {
+
+            if (boost::trim_copy(text_line).empty()) continue;
+
+            std::vector<std::string> tokens;
+            boost::split(tokens, text_line, boost::is_any_of("="));
+            if (tokens.size() != 2) {
+                std::cerr << "cannot parse line of input file: " << text_line << std::endl;
+                assert(false);
+            }
+
+            const std::string key = boost::trim_copy(tokens.at(0));
+            const std::string values = boost::trim_copy(tokens.at(1));
+
+            if (!read_statistics_registry_option(registry, key, values)) {
+                std::cerr << "unknown key in input file: " << key << std::endl;
+                assert(false);
+            }
+        }
+
+        return registry;
+    }
+
+}
+
+#endif	/* STATISTICS_REGISTRY_H */
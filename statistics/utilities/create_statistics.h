@@ -21,7 +21,9 @@ namespace monte_carlo {
                 read_policy.get_error_prob(),
                 Pop(0), // observe statistics in first sub-population
                 Spe(read_policy.get_population().number_species() - 1), // observe statistics in last species
-                read_policy.get_observer_divisor());
+                read_policy.get_observer_divisor(),
+                "", // no filename prefix
+                read_policy.get_statistics_registry());
 
 
     }
@@ -1,7 +1,7 @@
 #ifndef MEAN_POP_DIST_H
 #define	MEAN_POP_DIST_H
 
-#include <mutation_accumulation/utility/distribution_traits.h> // distribution_types::pmf_type
+#include <mutation_accumulation/utility/distribution_traits.h> // distribution_types::pmf_bool_type
 #include <mutation_accumulation/utility/data_traits.h> // data_types::discrete_type
 #include <mutation_accumulation/statistics/statistics/distribution_statistics_population.h> // monte_carlo::Distribution_Statistics_Population
 
@@ -12,7 +12,7 @@ namespace monte_carlo {
     namespace mean_detail {
 
         /** 
-         * calculate mean given that distribution is PMF, \n
+         * calculate mean given that distribution is PMF with a boolean sample space, \n
          * which implies that sample type is discrete: int, long long int, bool \n
          * assumes that PMF is defined for each integer \n
          * assumes that pmf reaches close enough to zero
@@ -21,7 +21,7 @@ namespace monte_carlo {
         template<class sample_type>
         const double calculate_mean(
         const probability::SampleSpace_Probability<sample_type> &sampleSpace_probability,
-        distribution_types::pmf_type) {
+        distribution_types::pmf_bool_type) {
 
             const std::vector<sample_type> _sample_space = sampleSpace_probability.sample_space();
             const std::vector<double> _probability = sampleSpace_probability.probability();
@@ -39,6 +39,11 @@ namespace monte_carlo {
          * this function is yet to be implemented
          */
 
+        template<class sample_type>
+        const double calculate_mean_cdf(
+        const probability::SampleSpace_Probability<sample_type> &sampleSpace_probability,
+        data_types::discrete_type);
+
         /** 
          * calculate mean given that distribution is CDF \n
          * sample type is discrete or continuous\n
@@ -52,9 +57,12 @@ namespace monte_carlo {
             return calculate_mean_cdf(sampleSpace_probability, sample_category);
         }
 
-        /** 
+        /**
          * calculate mean given that distribution is CDF and sample type is discrete\n
-         * assumes that CDF is defined for each integer \n
+         * <X> = \sum_{x >= 0} (1 - P(X <= x)) \n
+         * CDF at integers strictly between consecutive sample points is interpolated linearly, \n
+         * so each gap between sample points is weighted by its width (exact when CDF is defined for each integer) \n
+         * assumes that sample space starts at zero \n
          * assumes that cdf reaches close enough to unity
          * TESTED
          */
@@ -63,11 +71,17 @@ namespace monte_carlo {
         const probability::SampleSpace_Probability<sample_type> &sampleSpace_probability,
         data_types::discrete_type) {
 
+            const std::vector<sample_type> _sample_space = sampleSpace_probability.sample_space();
             const std::vector<double> _probability = sampleSpace_probability.probability();
 
             double mean = 0.0;
-            for (int ii = 0; ii < _probability.size(); ii++)
+            for (int ii = 0; ii < _probability.size(); ii++) {
                 mean += 1.0 - _probability.at(ii);
+                if (ii + 1 < _probability.size()) {
+                    const double number_interior = static_cast<double> (_sample_space.at(ii + 1) - _sample_space.at(ii) - 1);
+                    mean += number_interior * (1.0 - 0.5 * (_probability.at(ii) + _probability.at(ii + 1)));
+                }
+            }
 
             return mean;
         }
@@ -81,33 +95,29 @@ namespace monte_carlo {
 
     /** 
      * print mean of population probability distributions versus time \n
+     * means are the exact sums kept by Distribution_Statistics_Population, \n
+     * rather than estimates from its log-linear sample space, which is coarse at large populations \n
      * better to calculate moments directly using classes derived from Moment_Statistics\n
      */
     template<class Histogram_type, class Configuration_type>
-    const double print_mean_populations(
+    void print_mean_populations(
     const Distribution_Statistics_Population<Histogram_type, Configuration_type> &statistics,
     const Pop &pop,
     const Spe &spe) {
 
-        typedef typename Distribution_Statistics_Population<Histogram_type, Configuration_type>::Results_t Results_t;
-        const array::Array3D<Results_t> array3D_results = statistics.get_results_so_far();
-
         std::string filename =
                 "meanPopulationVersusTime__pop" + boost::lexical_cast<std::string > (pop.value()) +
                 "__spe" + boost::lexical_cast<std::string > (spe.value()) +
                 ".dat";
         boost::shared_ptr<std::ofstream> ofstream_ptr = monte_carlo::open_file_for_output(filename);
 
-        for (int node = 0; node < array3D_results.get_dim2(); node++) {
+        for (int node = 0; node < statistics.time_grid().size(); node++) {
 
             typedef typename Distribution_Statistics_Population<Histogram_type, Configuration_type>::Configuration_t::time_t time_type;
             const time_type tt = statistics.time_grid().at(Node(node));
             *ofstream_ptr << std::setw(30) << std::setprecision(20) << tt;
 
-            typename Distribution_Statistics_Population<Histogram_type, Configuration_type>::Histogram_t::category distribution_category;
-            const double mean = mean_detail::calculate_mean(
-                    array3D_results.at(pop.value(), spe.value(), node),
-                    distribution_category);
+            const double mean = statistics.mean(pop, spe, Node(node));
             *ofstream_ptr << std::setw(30) << std::setprecision(20) << mean;
 
             *ofstream_ptr << std::endl;
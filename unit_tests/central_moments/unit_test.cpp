@@ -0,0 +1,134 @@
+#include <iostream> // std::cout
+#include <vector> // std::vector
+#include <cmath> // std::fabs, std::sqrt
+#include <cassert> // assert
+
+#include <mutation_accumulation/probability/mean.h> // probability::Mean
+#include <mutation_accumulation/probability/central_moments.h> // probability::Central_Moments
+
+#include "unit_test.h"
+
+/*************************************************************************/
+
+namespace {
+
+    const bool close(const double &xx, const double &yy, const double &tolerance) {
+
+        return std::fabs(xx - yy) <= tolerance * (1.0 + std::fabs(yy));
+    }
+
+}
+
+void unit_test::unit_test_central_moments() {
+
+    std::cout << "testing probability::Mean and probability::Central_Moments..." << std::endl;
+
+    /* skewed samples on top of a large offset, which defeats the naive sum-of-squares formula */
+    const double offset = 1e9;
+    std::vector<double> samples;
+    for (int ii = 0; ii < 1000; ii++)
+        samples.push_back(offset + static_cast<double> ((ii * ii) % 97) * 0.5);
+
+    /* two-pass reference values */
+    double mean = 0.0;
+    for (int ii = 0; ii < samples.size(); ii++)
+        mean += samples.at(ii);
+    mean /= samples.size();
+
+    double m2 = 0.0, m3 = 0.0, m4 = 0.0;
+    for (int ii = 0; ii < samples.size(); ii++) {
+        const double dd = samples.at(ii) - mean;
+        m2 += dd * dd;
+        m3 += dd * dd * dd;
+        m4 += dd * dd * dd * dd;
+    }
+    const double nn = samples.size();
+    const double variance = m2 / (nn - 1.0);
+    const double skewness = std::sqrt(nn) * m3 / std::pow(m2, 1.5);
+    const double kurtosis = nn * m4 / (m2 * m2) - 3.0;
+
+    {
+        /* check sequential updating */
+
+        std::cout << "checking sequential updating..." << std::endl;
+        probability::Mean<double> mean_estimate;
+        probability::Central_Moments<double> moments_estimate;
+        for (int ii = 0; ii < samples.size(); ii++) {
+            mean_estimate.update(samples.at(ii));
+            moments_estimate.update(samples.at(ii));
+        }
+
+        assert(mean_estimate.trials() == samples.size());
+        assert(close(mean_estimate.value(), mean, 1e-12));
+        assert(close(mean_estimate.variance(), variance, 1e-6));
+        std::cout << "passed: Mean agrees with two-pass mean and variance despite large offset" << std::endl;
+
+        assert(close(moments_estimate.value(), mean, 1e-12));
+        assert(close(moments_estimate.variance(), variance, 1e-6));
+        assert(close(moments_estimate.skewness(), skewness, 1e-6));
+        assert(close(moments_estimate.kurtosis(), kurtosis, 1e-6));
+        std::cout << "passed: Central_Moments agrees with two-pass mean, variance, skewness and kurtosis" << std::endl;
+
+        assert(close(mean_estimate.standard_error(), std::sqrt(variance / nn), 1e-6));
+        std::cout << "passed: standard error is sqrt(variance / number of samples)" << std::endl;
+    }
+
+    {
+        /* check merging of unequal shards */
+
+        std::cout << "checking merging..." << std::endl;
+        probability::Mean<double> mean_first, mean_second, mean_third;
+        probability::Central_Moments<double> moments_first, moments_second, moments_third;
+        for (int ii = 0; ii < samples.size(); ii++) {
+            if (ii < 100) {
+                mean_first.update(samples.at(ii));
+                moments_first.update(samples.at(ii));
+            } else if (ii < 700) {
+                mean_second.update(samples.at(ii));
+                moments_second.update(samples.at(ii));
+            } else {
+                mean_third.update(samples.at(ii));
+                moments_third.update(samples.at(ii));
+            }
+        }
+
+        /* (first + second) + third */
+        probability::Mean<double> mean_left(mean_first);
+        mean_left.merge(mean_second);
+        mean_left.merge(mean_third);
+        probability::Central_Moments<double> moments_left(moments_first);
+        moments_left.merge(moments_second);
+        moments_left.merge(moments_third);
+
+        /* first + (second + third) */
+        probability::Central_Moments<double> moments_right(moments_second);
+        moments_right.merge(moments_third);
+        probability::Central_Moments<double> moments_all(moments_first);
+        moments_all.merge(moments_right);
+
+        assert(mean_left.trials() == samples.size());
+        assert(close(mean_left.value(), mean, 1e-12));
+        assert(close(mean_left.variance(), variance, 1e-6));
+        std::cout << "passed: merged Mean agrees with two-pass mean and variance" << std::endl;
+
+        assert(moments_left.trials() == samples.size());
+        assert(close(moments_left.value(), mean, 1e-12));
+        assert(close(moments_left.variance(), variance, 1e-6));
+        assert(close(moments_left.skewness(), skewness, 1e-6));
+        assert(close(moments_left.kurtosis(), kurtosis, 1e-6));
+        std::cout << "passed: merged Central_Moments agrees with two-pass moments" << std::endl;
+
+        assert(close(moments_all.variance(), moments_left.variance(), 1e-9));
+        assert(close(moments_all.skewness(), moments_left.skewness(), 1e-9));
+        assert(close(moments_all.kurtosis(), moments_left.kurtosis(), 1e-9));
+        std::cout << "passed: merging is associative" << std::endl;
+
+        probability::Central_Moments<double> moments_empty;
+        moments_empty.merge(moments_all);
+        assert(moments_empty.trials() == moments_all.trials());
+        assert(close(moments_empty.variance(), moments_all.variance(), 1e-12));
+        std::cout << "passed: merging into an empty estimate copies it" << std::endl;
+    }
+
+}
+
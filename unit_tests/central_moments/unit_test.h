@@ -0,0 +1,17 @@
+#ifndef UNIT_TEST_H
+#define	UNIT_TEST_H
+
+/*************************************************************************/
+
+namespace unit_test {
+
+    /**
+     * test probability::Mean and probability::Central_Moments against two-pass formulae\n
+     * checks numerical stability with a large offset, and that merging agrees with sequential updating
+     */
+    void unit_test_central_moments();
+
+}
+
+#endif	/* UNIT_TEST_H */
+
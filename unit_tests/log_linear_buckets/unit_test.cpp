@@ -0,0 +1,104 @@
+#include <iostream> // std::cout
+#include <vector> // std::vector
+#include <cmath> // std::fabs
+#include <cassert> // assert
+
+#include <mutation_accumulation/probability/log_linear_buckets.h> // probability::Log_Linear_Buckets
+
+#include "unit_test.h"
+
+/*************************************************************************/
+
+void unit_test::unit_test_log_linear_buckets() {
+
+    std::cout << "testing probability::Log_Linear_Buckets..." << std::endl;
+
+    const int bits = 4;
+
+    {
+        /* check discrete samples */
+
+        std::cout << "checking discrete samples..." << std::endl;
+        probability::Log_Linear_Buckets<int> buckets(bits);
+        for (int sample = 0; sample < 1000; sample++)
+            buckets.insert(sample);
+        assert(buckets.number_samples() == 1000);
+
+        std::vector<int> grid;
+        for (int xx = 0; xx < 16; xx++)
+            grid.push_back(xx);
+        const std::vector<double> counts = buckets.count_below(grid);
+        for (int ii = 0; ii < grid.size(); ii++)
+            assert(counts.at(ii) == grid.at(ii) + 1);
+        std::cout << "passed: samples smaller than 2^bits are counted exactly" << std::endl;
+
+        std::vector<int> coarse_grid;
+        for (int xx = 16; xx < 1000; xx += 37)
+            coarse_grid.push_back(xx);
+        const std::vector<double> coarse_counts = buckets.count_below(coarse_grid);
+        for (int ii = 0; ii < coarse_grid.size(); ii++) {
+            const double exact = coarse_grid.at(ii) + 1;
+            assert(std::fabs(coarse_counts.at(ii) - exact) <= exact / (1 << bits));
+        }
+        std::cout << "passed: counts of larger samples have relative error at most 2^-bits" << std::endl;
+
+        assert(buckets.number_buckets() < 1000);
+        std::cout << "passed: fewer buckets than distinct samples" << std::endl;
+    }
+
+    {
+        /* check continuous samples */
+
+        std::cout << "checking continuous samples..." << std::endl;
+        probability::Log_Linear_Buckets<double> buckets(bits);
+        buckets.insert(0.0);
+        for (int ii = 1; ii <= 1000; ii++)
+            buckets.insert(0.01 * ii);
+
+        std::vector<double> grid;
+        grid.push_back(0.0);
+        grid.push_back(1e-6);
+        for (double xx = 0.5; xx < 10.0; xx += 0.5)
+            grid.push_back(xx);
+        const std::vector<double> counts = buckets.count_below(grid);
+        assert(counts.at(0) == 0.0);
+        assert(counts.at(1) == 1.0);
+        std::cout << "passed: zero samples are counted as smaller than any positive value" << std::endl;
+
+        for (int ii = 2; ii < grid.size(); ii++) {
+            const double exact = 1.0 + std::floor(grid.at(ii) / 0.01 - 1e-9);
+            assert(std::fabs(counts.at(ii) - exact) <= exact / (1 << bits) + 1.0);
+            assert(counts.at(ii) >= counts.at(ii - 1));
+        }
+        std::cout << "passed: counts have relative error at most 2^-bits and are non-decreasing" << std::endl;
+
+        const double median = buckets.quantile(0.5);
+        assert(std::fabs(median - 5.0) <= 5.0 / (1 << bits));
+        std::cout << "passed: quantile has relative error at most 2^-bits" << std::endl;
+    }
+
+    {
+        /* check merging */
+
+        std::cout << "checking merging..." << std::endl;
+        probability::Log_Linear_Buckets<int> all(bits), first(bits), second(bits);
+        for (int sample = 0; sample < 500; sample++) {
+            all.insert(sample * 7);
+            if (sample % 2 == 0) first.insert(sample * 7);
+            else second.insert(sample * 7);
+        }
+        first.merge(second);
+        assert(first.number_samples() == all.number_samples());
+
+        std::vector<int> grid;
+        for (int xx = 0; xx < 3500; xx += 100)
+            grid.push_back(xx);
+        const std::vector<double> merged_counts = first.count_below(grid);
+        const std::vector<double> counts = all.count_below(grid);
+        for (int ii = 0; ii < grid.size(); ii++)
+            assert(merged_counts.at(ii) == counts.at(ii));
+        std::cout << "passed: merged buckets equal buckets filled with all samples" << std::endl;
+    }
+
+}
+
@@ -0,0 +1,17 @@
+#ifndef UNIT_TEST_H
+#define	UNIT_TEST_H
+
+/*************************************************************************/
+
+namespace unit_test {
+
+    /**
+     * test probability::Log_Linear_Buckets against exact counts of discrete and continuous samples\n
+     * checks exactness below 2^bits, relative resolution above, merging, and quantiles
+     */
+    void unit_test_log_linear_buckets();
+
+}
+
+#endif	/* UNIT_TEST_H */
+
@@ -0,0 +1,10 @@
+#include "unit_test.h"
+
+/*************************************************************************/
+
+int main() {
+
+    unit_test::unit_test_log_linear_buckets();
+    
+}
+
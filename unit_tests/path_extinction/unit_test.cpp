@@ -0,0 +1,94 @@
+#include <iostream> // std::cout
+#include <vector> // std::vector
+#include <cmath> // std::fabs
+#include <cassert> // assert
+
+#include <mutation_accumulation/configuration/configuration/path.h> // monte_carlo::Path
+#include <mutation_accumulation/configuration/configuration/branching_discrete.h> // monte_carlo::Branching_Discrete
+#include <mutation_accumulation/configuration/utilities/create_configuration.h> // monte_carlo::create_configuration
+#include <mutation_accumulation/configuration/configuration/path_policy.h> // monte_carlo::Fixed_Duration
+#include <mutation_accumulation/statistics/statistics/moment_statistics_population.h> // monte_carlo::Moment_Statistics_Population
+#include <mutation_accumulation/probability/mean.h> // probability::Mean
+#include <mutation_accumulation/simulation/generate_statistics.h> // monte_carlo::Generate_Statistics
+
+#include "unit_test.h"
+
+/*************************************************************************/
+
+namespace {
+
+    /**
+     * record the nodes crossed, and the population of the first species of the first sub-population at each
+     */
+    class Record_Nodes : public monte_carlo::Node_Listener<int> {
+    public:
+
+        std::vector<int> nodes;
+        std::vector<int> populations;
+
+        virtual void node_crossed(const monte_carlo::Node &node, const monte_carlo::Population2D<int> &node_value) {
+
+            nodes.push_back(node.value());
+            populations.push_back(node_value.at(0, 0));
+        }
+    };
+
+}
+
+void unit_test::unit_test_path_extinction() {
+
+    std::cout << "testing path populations of extinct trajectories..." << std::endl;
+
+    {
+        /* check that a path fills the nodes it did not reach */
+
+        std::cout << "checking monte_carlo::Path..." << std::endl;
+        const monte_carlo::Uniform_Time_Grid<int> time_grid(11, 10);
+        const monte_carlo::Population2D<int> alive(std::vector<int>(2, 3));
+        const monte_carlo::Population2D<int> extinct(std::vector<int>(2, 0));
+
+        monte_carlo::Path<int, int> path(alive, time_grid);
+        Record_Nodes record_nodes;
+        path.attach_listener(&record_nodes);
+        for (int tt = 1; tt <= 4; tt++)
+            path.update(tt, alive);
+        assert(!path.complete());
+
+        path.fill_remaining_nodes(extinct);
+        assert(path.complete());
+        assert(record_nodes.nodes.size() == time_grid.size());
+        for (int node = 0; node < time_grid.size(); node++) {
+            assert(record_nodes.nodes.at(node) == node);
+            assert(record_nodes.populations.at(node) == (node <= 4 ? 3 : 0));
+        }
+        std::cout << "passed: every node is crossed once, with zero populations after extinction" << std::endl;
+    }
+
+    {
+        /* check that the mean population of a critical branching process is constant in time; \n
+         * counting only trajectories that survive to a node would inflate the mean there */
+
+        std::cout << "checking mean population of a critical branching process..." << std::endl;
+        typedef monte_carlo::Branching_Discrete<int> Configuration_type;
+        const monte_carlo::Uniform_Time_Grid<int> time_grid(11, 50);
+        std::vector<int> populations(2, 0);
+        populations.at(0) = 1;
+        const monte_carlo::Population2D<int> NN(populations);
+        monte_carlo::MutationRates uu(1);
+        uu.at(0) = 0.0;
+
+        Configuration_type::category configuration_category;
+        const Configuration_type configuration_init = monte_carlo::create_configuration<Configuration_type > (configuration_category, NN, uu, monte_carlo::Symmetry(0.5), time_grid);
+
+        typedef monte_carlo::Moment_Statistics_Population<probability::Mean<int>, Configuration_type> Statistics_type;
+        Statistics_type statistics(monte_carlo::Number_Pop(1), monte_carlo::Number_Spe(2), time_grid, 0.05, 0.05, 40000);
+        monte_carlo::Generate_Statistics<monte_carlo::Fixed_Duration<Configuration_type>, Configuration_type, Statistics_type>::implement(configuration_init, statistics, 12345);
+
+        const array::Array3D<double> means = statistics.get_results_so_far();
+        for (int node = 0; node < time_grid.size(); node++)
+            assert(std::fabs(means.at(0, 0, node) - 1.0) < 0.2);
+        std::cout << "passed: mean population stays at its initial value at every node" << std::endl;
+    }
+
+}
+
@@ -0,0 +1,17 @@
+#ifndef UNIT_TEST_H
+#define	UNIT_TEST_H
+
+/*************************************************************************/
+
+namespace unit_test {
+
+    /**
+     * test that trajectories that go extinct contribute zero populations to the nodes they do not reach\n
+     * checks monte_carlo::Path directly, and the mean population of a critical branching process, which is constant in time
+     */
+    void unit_test_path_extinction();
+
+}
+
+#endif	/* UNIT_TEST_H */
+
@@ -0,0 +1,10 @@
+#include "unit_test.h"
+
+/*************************************************************************/
+
+int main() {
+
+    unit_test::unit_test_path_extinction();
+    
+}
+
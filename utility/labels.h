@@ -1,6 +1,11 @@
 #ifndef LABELS_H
 #define	LABELS_H
 
+#include <string> // std::string
+
+#include <mutation_accumulation/probability/mean.h> // probability::Mean
+#include <mutation_accumulation/probability/central_moments.h> // probability::Central_Moments
+
 /*************************************************************************/
 
 namespace labels {
@@ -14,6 +19,15 @@ namespace labels {
         return std::string("mean");
     }
 
+    /** 
+     * create label appropriate for central moments, whose value is the mean 
+     */
+    template <class sample_type>
+    const std::string create_label(probability::Central_Moments<sample_type>) {
+
+        return std::string("mean");
+    }
+
 
 }
 
@@ -0,0 +1,128 @@
+#ifndef WORKER_POOL_H
+#define	WORKER_POOL_H
+
+#include <vector> // std::vector
+#include <thread> // std::thread
+#include <mutex> // std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <functional> // std::function
+
+#include <boost/utility.hpp> // boost::noncopyable
+
+/*************************************************************************/
+
+namespace workers {
+
+    /**
+     * threads that are created once, and then run the same job concurrently each time run(..) is called \n
+     * the calling thread runs the job too, so a pool of number_threads threads holds number_threads - 1 workers \n
+     * jobs share out their own work (e.g. by claiming items from an atomic counter), so each must tolerate finding none left \n
+     * calls to run(..) from different threads are served one at a time \n
+     * uncopyable, since it owns its threads (Item 6)
+     */
+    class Worker_Pool : private boost::noncopyable {
+    private:
+
+        std::vector<std::thread> _workers;
+
+        std::mutex _run_mutex; // serves one call to run(..) at a time
+        std::mutex _mutex; // guards the members below
+        std::condition_variable _job_posted;
+        std::condition_variable _job_done;
+
+        const std::function<void ()> *_job;
+        long long int _job_number; // number of jobs posted so far
+        int _busy_workers; // workers still running the current job
+        bool _stop;
+
+    private:
+
+        /**
+         * worker body: wait for each new job, run it, and report when done
+         */
+        void work() {
+
+            long long int jobs_run = 0;
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true) {
+
+                while (!_stop && (_job_number == jobs_run))
+                    _job_posted.wait(lock);
+                if (_stop) return;
+
+                jobs_run = _job_number;
+                const std::function<void ()> *job = _job;
+
+                lock.unlock();
+                (*job)();
+                lock.lock();
+
+                if (--_busy_workers == 0) _job_done.notify_one();
+            }
+        }
+
+    public:
+
+        /**
+         * constructor \n
+         * starts number_threads - 1 workers, which wait for jobs
+         */
+        explicit Worker_Pool(const int &number_threads)
+        : _job(0), _job_number(0), _busy_workers(0), _stop(false) {
+
+            for (int ww = 1; ww < number_threads; ww++)
+                _workers.push_back(std::thread(&Worker_Pool::work, this));
+        }
+
+        /**
+         * stops and joins the workers
+         */
+        ~Worker_Pool() {
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _job_posted.notify_all();
+
+            for (std::vector<std::thread>::size_type ww = 0; ww < _workers.size(); ww++)
+                _workers.at(ww).join();
+        }
+
+        /**
+         * run job on every worker and on the calling thread, and return once all have finished
+         */
+        void run(const std::function<void ()> &job) {
+
+            std::lock_guard<std::mutex> run_lock(_run_mutex);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _job = &job;
+                _busy_workers = static_cast<int> (_workers.size());
+                _job_number++;
+            }
+            _job_posted.notify_all();
+
+            job();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (_busy_workers > 0)
+                _job_done.wait(lock);
+            _job = 0;
+        }
+
+        /**
+         * number of threads that run each job, including the calling thread
+         */
+        const int number_threads() const {
+
+            return static_cast<int> (_workers.size()) + 1;
+        }
+
+    };
+
+}
+
+#endif	/* WORKER_POOL_H */